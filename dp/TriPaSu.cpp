@@ -1,6 +1,8 @@
 #include <iostream>
 #include <vector>
 #include <algorithm>
+#include <stdexcept>
+#include "counting.h"
 
 // TriPaSu: Triangle, Pascal's Triangle, and Sum variants
 // Time Complexity: O(n^2)
@@ -63,31 +65,72 @@ int maxPathSum(const std::vector<std::vector<int>>& triangle) {
 }
 
 // Count paths with given sum in triangle
-int countPathsWithSum(const std::vector<std::vector<int>>& triangle, int targetSum) {
+// Time: O(n^2 * targetSum), Space: O(n * targetSum)
+// Count selects the arithmetic: ModInt<P>, Count128 or BigCount (see counting.h)
+// Row i only depends on row i-1, so two flat buffers of (n x (targetSum+1))
+// counts replace the n x n x (targetSum+1) cube. Each cell also tracks the
+// [lo, hi] range of sums a path can actually reach; everything outside it is
+// zero and never touched. A cell's sums are its parents' shifted by its value,
+// added over contiguous ranges in vector lanes.
+// Entries must be non-negative: a path's running sum then never drops below
+// zero, which is what lets the sums index the buffers directly.
+template <typename Count = Mod1e9_7>
+Count countPathsWithSum(const std::vector<std::vector<int>>& triangle, int targetSum) {
+    for (const std::vector<int>& row : triangle) {
+        for (int value : row) {
+            if (value < 0) throw std::runtime_error("countPathsWithSum: negative entry");
+        }
+    }
     int n = triangle.size();
-    std::vector<std::vector<std::vector<int>>> dp(
-        n, std::vector<std::vector<int>>(n, std::vector<int>(targetSum + 1, 0))
-    );
+    if (n == 0 || targetSum < 0) return Count(0);
+    int width = targetSum + 1;
+    
+    std::vector<Count> prev((size_t)n * width), curr((size_t)n * width);
+    std::vector<int> prevLo(n), prevHi(n), currLo(n), currHi(n);
     
+    // Empty range is lo > hi
+    prevLo[0] = triangle[0][0];
+    prevHi[0] = triangle[0][0];
     if (triangle[0][0] <= targetSum)
-        dp[0][0][triangle[0][0]] = 1;
+        prev[triangle[0][0]] = Count(1);
     
     for (int i = 1; i < n; i++) {
         for (int j = 0; j <= i; j++) {
-            for (int sum = triangle[i][j]; sum <= targetSum; sum++) {
-                if (j > 0 && dp[i-1][j-1][sum - triangle[i][j]] > 0) {
-                    dp[i][j][sum] += dp[i-1][j-1][sum - triangle[i][j]];
-                }
-                if (j < i && dp[i-1][j][sum - triangle[i][j]] > 0) {
-                    dp[i][j][sum] += dp[i-1][j][sum - triangle[i][j]];
-                }
+            int value = triangle[i][j];
+            int lo = targetSum + 1, hi = -1;
+            if (j > 0) {
+                lo = std::min(lo, prevLo[j-1] + value);
+                hi = std::max(hi, prevHi[j-1] + value);
+            }
+            if (j < i) {
+                lo = std::min(lo, prevLo[j] + value);
+                hi = std::max(hi, prevHi[j] + value);
+            }
+            hi = std::min(hi, targetSum);
+            currLo[j] = lo;
+            currHi[j] = hi;
+            if (lo > hi) continue;
+            
+            // Clear what this buffer held two rows ago, then add the parents
+            Count* cell = &curr[(size_t)j * width];
+            std::fill(cell + lo, cell + hi + 1, Count(0));
+            for (int parent = j - 1; parent <= j; parent++) {
+                if (parent < 0 || parent >= i) continue;
+                int from = std::max(prevLo[parent], 0);
+                int to = std::min(prevHi[parent], targetSum - value);
+                if (from > to) continue;
+                addLanes(&prev[(size_t)parent * width + from], cell + from + value, to - from + 1);
             }
         }
+        prev.swap(curr);
+        prevLo.swap(currLo);
+        prevHi.swap(currHi);
     }
     
-    int count = 0;
+    Count count(0);
     for (int j = 0; j < n; j++) {
-        count += dp[n-1][j][targetSum];
+        if (prevLo[j] <= targetSum && targetSum <= prevHi[j])
+            count += prev[(size_t)j * width + targetSum];
     }
     
     return count;
@@ -117,6 +160,17 @@ int main() {
     
     std::cout << "\nMinimum path sum: " << minimumTotal(triangle) << std::endl;
     std::cout << "Maximum path sum: " << maxPathSum(triangle) << std::endl;
+    std::cout << "Paths with sum 11: " << countPathsWithSum(triangle, 11) << std::endl;
+    
+    // 1000 rows with target 10^3: the old n x n x target cube was ~4 GB
+    int bigRows = 1000, bigTarget = 1000;
+    std::vector<std::vector<int>> big(bigRows);
+    for (int i = 0; i < bigRows; i++) {
+        for (int j = 0; j <= i; j++)
+            big[i].push_back((i + 2 * j) % 3);
+    }
+    std::cout << "Paths with sum " << bigTarget << " in a " << bigRows << "-row triangle: "
+              << countPathsWithSum(big, bigTarget) << " (mod 1e9+7)" << std::endl;
     
     std::cout << "\n=== Pascal's Triangle ===" << std::endl;
     int numRows = 5;
@@ -0,0 +1,272 @@
+#ifndef COUNTING_H
+#define COUNTING_H
+
+#include <iostream>
+#include <vector>
+#include <string>
+#include <algorithm>
+#include <cstdint>
+#include <type_traits>
+
+// Count types for counting DPs
+// Path and subset counts grow exponentially and silently overflow an int.
+// Every counting DP is templated on its count type, chosen per call:
+//   ModInt<P>   - counts modulo a prime P (the usual 1e9+7 or 998244353)
+//   Count128    - exact up to 2^128 - 1
+//   BigCount    - exact, arbitrary precision
+// A count type needs Count(0), Count(1), += and printing.
+
+// Modular count with a configurable prime
+// Addition is a compare-and-subtract, so DP rows of ModInt vectorize. The sum
+// of two residues must fit in 32 bits for that, hence P < 2^31.
+template <uint32_t P>
+class ModInt {
+    static_assert(P > 1 && P < (1u << 31), "ModInt needs 1 < P < 2^31");
+    
+private:
+    uint32_t v;
+
+public:
+    static const uint32_t MOD = P;
+    
+    ModInt() : v(0) {}
+    ModInt(long long x) : v((uint32_t)(((x % (long long)P) + P) % P)) {}
+    
+    uint32_t value() const { return v; }
+    
+    ModInt& operator+=(const ModInt& other) {
+        uint32_t sum = v + other.v;
+        v = sum >= P ? sum - P : sum;
+        return *this;
+    }
+    
+    ModInt& operator*=(const ModInt& other) {
+        v = (uint32_t)((uint64_t)v * other.v % P);
+        return *this;
+    }
+    
+    friend ModInt operator+(ModInt a, const ModInt& b) { return a += b; }
+    friend ModInt operator*(ModInt a, const ModInt& b) { return a *= b; }
+    friend bool operator==(const ModInt& a, const ModInt& b) { return a.v == b.v; }
+    
+    ModInt pow(uint64_t exp) const {
+        ModInt result(1), base = *this;
+        while (exp > 0) {
+            if (exp & 1) result *= base;
+            base *= base;
+            exp >>= 1;
+        }
+        return result;
+    }
+    
+    // Fermat's little theorem, P must be prime
+    ModInt inverse() const { return pow(P - 2); }
+    
+    friend std::ostream& operator<<(std::ostream& os, const ModInt& x) {
+        return os << x.v;
+    }
+};
+
+const uint32_t MOD_1E9_7 = 1000000007;
+using Mod1e9_7 = ModInt<MOD_1E9_7>;
+
+// 128-bit exact count (GCC/Clang extension)
+using Count128 = unsigned __int128;
+
+inline std::ostream& operator<<(std::ostream& os, Count128 x) {
+    if (x == 0) return os << '0';
+    std::string digits;
+    while (x > 0) {
+        digits.push_back('0' + (int)(x % 10));
+        x /= 10;
+    }
+    std::reverse(digits.begin(), digits.end());
+    return os << digits;
+}
+
+// Arbitrary precision count
+// Base 10^9 limbs, least significant first. Only the operations counting DPs
+// need: addition, and multiply / exact divide by a small factor for binomials.
+class BigCount {
+private:
+    static const uint32_t BASE = 1000000000;
+    std::vector<uint32_t> limbs;
+
+public:
+    BigCount(unsigned long long x = 0) {
+        do {
+            limbs.push_back(x % BASE);
+            x /= BASE;
+        } while (x > 0);
+    }
+    
+    BigCount& operator+=(const BigCount& other) {
+        if (other.limbs.size() > limbs.size()) {
+            limbs.resize(other.limbs.size(), 0);
+        }
+        uint32_t carry = 0;
+        for (size_t i = 0; i < limbs.size(); i++) {
+            uint32_t sum = limbs[i] + carry + (i < other.limbs.size() ? other.limbs[i] : 0);
+            carry = sum >= BASE;
+            limbs[i] = carry ? sum - BASE : sum;
+        }
+        if (carry) limbs.push_back(carry);
+        return *this;
+    }
+    
+    friend BigCount operator+(BigCount a, const BigCount& b) { return a += b; }
+    friend bool operator==(const BigCount& a, const BigCount& b) { return a.limbs == b.limbs; }
+    
+    BigCount& mulSmall(uint32_t factor) {
+        uint64_t carry = 0;
+        for (uint32_t& limb : limbs) {
+            uint64_t cur = (uint64_t)limb * factor + carry;
+            limb = cur % BASE;
+            carry = cur / BASE;
+        }
+        while (carry > 0) {
+            limbs.push_back(carry % BASE);
+            carry /= BASE;
+        }
+        if (factor == 0) limbs.assign(1, 0);
+        return *this;
+    }
+    
+    // Caller guarantees the division is exact
+    BigCount& divSmall(uint32_t divisor) {
+        uint64_t rem = 0;
+        for (size_t i = limbs.size(); i-- > 0;) {
+            uint64_t cur = limbs[i] + rem * BASE;
+            limbs[i] = cur / divisor;
+            rem = cur % divisor;
+        }
+        while (limbs.size() > 1 && limbs.back() == 0) {
+            limbs.pop_back();
+        }
+        return *this;
+    }
+    
+    friend std::ostream& operator<<(std::ostream& os, const BigCount& x) {
+        os << x.limbs.back();
+        for (size_t i = x.limbs.size() - 1; i-- > 0;) {
+            std::string part = std::to_string(x.limbs[i]);
+            os << std::string(9 - part.size(), '0') << part;
+        }
+        return os;
+    }
+};
+
+template <typename Count> struct IsModInt : std::false_type {};
+template <uint32_t P> struct IsModInt<ModInt<P>> : std::true_type {};
+
+// Factorial tables mod P, grown on demand and shared by every query
+template <uint32_t P>
+class FactorialTable {
+private:
+    static std::vector<ModInt<P>>& fact() { static std::vector<ModInt<P>> f(1, 1); return f; }
+    static std::vector<ModInt<P>>& invFact() { static std::vector<ModInt<P>> f(1, 1); return f; }
+
+public:
+    // Tables are only valid below P, where every factorial is invertible
+    static void ensure(int n) {
+        std::vector<ModInt<P>>& f = fact();
+        std::vector<ModInt<P>>& inv = invFact();
+        int old = f.size();
+        if (n < old) return;
+        
+        f.resize(n + 1);
+        inv.resize(n + 1);
+        for (int i = old; i <= n; i++) {
+            f[i] = f[i - 1] * ModInt<P>(i);
+        }
+        // One inversion, then walk the inverses back down
+        inv[n] = f[n].inverse();
+        for (int i = n; i > old; i--) {
+            inv[i - 1] = inv[i] * ModInt<P>(i);
+        }
+    }
+    
+    static ModInt<P> binomial(int n, int k) {
+        if (k < 0 || k > n) return ModInt<P>(0);
+        ensure(n);
+        return fact()[n] * invFact()[k] * invFact()[n - k];
+    }
+};
+
+template <typename T>
+T gcdCount(T a, T b) {
+    while (b != 0) {
+        T t = a % b;
+        a = b;
+        b = t;
+    }
+    return a;
+}
+
+// C(n, k) in any count type
+// Time: O(1) amortized for ModInt (factorial tables), O(k) otherwise
+template <typename Count>
+Count binomialCount(int n, int k) {
+    if (k < 0 || k > n) return Count(0);
+    k = std::min(k, n - k);
+    
+    if constexpr (IsModInt<Count>::value) {
+        return FactorialTable<Count::MOD>::binomial(n, k);
+    } else if constexpr (std::is_same<Count, BigCount>::value) {
+        BigCount result(1);
+        for (int i = 1; i <= k; i++) {
+            result.mulSmall(n - k + i).divSmall(i);
+        }
+        return result;
+    } else {
+        // C(n, i) = C(n, i-1) * (n-k+i) / i; cancel the gcd first so the
+        // intermediate product never exceeds the final result
+        Count result = 1;
+        for (int i = 1; i <= k; i++) {
+            Count num = n - k + i, den = i;
+            Count g = gcdCount(result, den);
+            result /= g;
+            den /= g;
+            num /= den;
+            result *= num;
+        }
+        return result;
+    }
+}
+
+// dst[i] = src[i] + src[i - shift] (src[i] alone below shift)
+// Reading one row and writing another keeps the buffers disjoint, so the fixed
+// 8-lane blocks compile to vector adds for ModInt and built-in count types.
+template <typename Count>
+void addShiftedLanes(const Count* __restrict src, Count* __restrict dst, int shift, int size) {
+    const int LANES = 8;
+    int i = 0;
+    for (; i < shift && i < size; i++) {
+        dst[i] = src[i];
+    }
+    for (; i + LANES <= size; i += LANES) {
+        for (int k = 0; k < LANES; k++) {
+            dst[i + k] = src[i + k] + src[i + k - shift];
+        }
+    }
+    for (; i < size; i++) {
+        dst[i] = src[i] + src[i - shift];
+    }
+}
+
+// dst[i] += src[i] over disjoint buffers, in the same 8-lane blocks
+template <typename Count>
+void addLanes(const Count* __restrict src, Count* __restrict dst, int size) {
+    const int LANES = 8;
+    int i = 0;
+    for (; i + LANES <= size; i += LANES) {
+        for (int k = 0; k < LANES; k++) {
+            dst[i + k] += src[i + k];
+        }
+    }
+    for (; i < size; i++) {
+        dst[i] += src[i];
+    }
+}
+
+#endif
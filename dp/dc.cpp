@@ -1,6 +1,14 @@
 #include <iostream>
 #include <vector>
 #include <algorithm>
+#include <climits>
+#include <cstdint>
+#include <string>
+#include <fstream>
+#include <stdexcept>
+#include <thread>
+#include <filesystem>
+#include "dpopt.h"
 
 // Divide and Conquer DP
 // Maximum sum subarray using D&C approach
@@ -39,6 +47,210 @@ int maxSubarrayDC(const std::vector<int>& arr, int left, int right) {
     return std::max({leftMax, rightMax, crossMax});
 }
 
+// Segment summaries
+// A segment is described by its total, best prefix, best suffix and best
+// subarray. Two adjacent segments combine in O(1): the crossing subarray is
+// the left suffix plus the right prefix, which is what maxCrossingSum finds by
+// scanning. Summaries therefore reduce in any grouping - halves, threads or
+// chunks of a stream - and only the leaves scan elements.
+struct SegmentSummary {
+    long long sum;
+    long long prefix;  // Best non-empty prefix
+    long long suffix;  // Best non-empty suffix
+    long long best;    // Best non-empty subarray
+};
+
+SegmentSummary combineSegments(const SegmentSummary& left, const SegmentSummary& right) {
+    return {left.sum + right.sum,
+            std::max(left.prefix, left.sum + right.prefix),
+            std::max(right.suffix, right.sum + left.suffix),
+            std::max({left.best, right.best, left.suffix + right.prefix})};
+}
+
+// Kadane's scan over arr[lo, hi), which must be non-empty
+SegmentSummary summarizeSegment(const int* arr, size_t lo, size_t hi) {
+    long long sum = 0, prefix = LLONG_MIN, best = LLONG_MIN;
+    long long ending = 0;    // Best sum ending at the previous element, or 0
+    long long minBefore = 0; // Smallest prefix sum before the current element
+    
+    for (size_t i = lo; i < hi; i++) {
+        minBefore = std::min(minBefore, sum);
+        sum += arr[i];
+        prefix = std::max(prefix, sum);
+        ending = std::max(ending, 0LL) + arr[i];
+        best = std::max(best, ending);
+    }
+    
+    return {sum, prefix, sum - minBefore, best};
+}
+
+// Below this many elements a task scans instead of splitting
+const size_t PARALLEL_CUTOFF = 1 << 16;
+
+// Task-based D&C: the left half runs on a new thread while this one takes
+// the right half, splitting the thread budget until it runs out
+SegmentSummary maxSubarrayTask(const int* arr, size_t lo, size_t hi, int threads) {
+    if (threads <= 1 || hi - lo < PARALLEL_CUTOFF) {
+        return summarizeSegment(arr, lo, hi);
+    }
+    
+    size_t mid = lo + (hi - lo) / 2;
+    SegmentSummary left;
+    std::thread worker([&] { left = maxSubarrayTask(arr, lo, mid, threads / 2); });
+    SegmentSummary right = maxSubarrayTask(arr, mid, hi, threads - threads / 2);
+    worker.join();
+    
+    return combineSegments(left, right);
+}
+
+// Parallel maximum subarray
+// Time: O(n / threads + log threads), Space: O(log threads)
+// 64-bit sums, so long arrays of large values do not overflow
+long long maxSubarrayParallel(const std::vector<int>& arr, int threads = 0) {
+    if (threads <= 0) {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    return maxSubarrayTask(arr.data(), 0, arr.size(), threads).best;
+}
+
+// Range maximum-subarray queries
+// A segment tree of SegmentSummary answers "best subarray inside [l, r]" for a
+// static series with point updates. Node v summarizes the union of its
+// children, leaves are single elements, and padding past n holds an identity
+// summary that leaves every combine unchanged.
+// Build: O(n / threads + log threads), Query/Update: O(log n), Space: O(n)
+class MaxSubarrayTree {
+private:
+    static constexpr long long NONE = LLONG_MIN / 4;  // -inf that survives additions
+    static constexpr SegmentSummary IDENTITY = {0, NONE, NONE, NONE};
+    
+    size_t leaves;  // Power of two >= n
+    size_t n;
+    std::vector<SegmentSummary> tree;
+    
+    static SegmentSummary leaf(int value) {
+        return {value, value, value, value};
+    }
+    
+    // Levels below depth log2(threads) split into independent subtrees, one
+    // per thread; the few nodes above them are combined serially
+    void build(const std::vector<int>& arr, int threads) {
+        int height = 0;
+        while ((size_t(1) << height) < leaves) height++;
+        int depth = 0;
+        while ((1 << (depth + 1)) <= threads && depth < height && n >= PARALLEL_CUTOFF) depth++;
+        size_t subtrees = size_t(1) << depth;
+        
+        auto buildSubtree = [&](size_t t) {
+            size_t span = leaves / subtrees;
+            for (size_t i = t * span; i < (t + 1) * span; i++) {
+                tree[leaves + i] = i < n ? leaf(arr[i]) : IDENTITY;
+            }
+            for (int level = height - 1; level >= depth; level--) {
+                size_t width = (size_t(1) << level) / subtrees;
+                size_t first = (size_t(1) << level) + t * width;
+                for (size_t v = first; v < first + width; v++) {
+                    tree[v] = combineSegments(tree[2 * v], tree[2 * v + 1]);
+                }
+            }
+        };
+        
+        std::vector<std::thread> pool;
+        for (size_t t = 1; t < subtrees; t++) {
+            pool.emplace_back(buildSubtree, t);
+        }
+        buildSubtree(0);
+        for (std::thread& worker : pool) {
+            worker.join();
+        }
+        
+        for (size_t v = subtrees - 1; v >= 1; v--) {
+            tree[v] = combineSegments(tree[2 * v], tree[2 * v + 1]);
+        }
+    }
+
+public:
+    explicit MaxSubarrayTree(const std::vector<int>& arr, int threads = 0)
+        : leaves(1), n(arr.size()) {
+        while (leaves < n) leaves <<= 1;
+        tree.resize(2 * leaves);
+        if (threads <= 0) {
+            threads = std::max(1u, std::thread::hardware_concurrency());
+        }
+        build(arr, threads);
+    }
+    
+    void update(size_t index, int value) {
+        size_t v = leaves + index;
+        tree[v] = leaf(value);
+        for (v /= 2; v >= 1; v /= 2) {
+            tree[v] = combineSegments(tree[2 * v], tree[2 * v + 1]);
+        }
+    }
+    
+    // Best subarray sum within arr[l..r], inclusive
+    long long query(size_t l, size_t r) const {
+        // Combine is not commutative: grow a left and a right summary inward
+        SegmentSummary left = IDENTITY, right = IDENTITY;
+        for (size_t lo = l + leaves, hi = r + leaves + 1; lo < hi; lo /= 2, hi /= 2) {
+            if (lo & 1) left = combineSegments(left, tree[lo++]);
+            if (hi & 1) right = combineSegments(tree[--hi], right);
+        }
+        return combineSegments(left, right).best;
+    }
+    
+    size_t size() const { return n; }
+};
+
+// Maximum sum subarray of length at most maxLen
+// With prefix sums P, the best subarray ending at i is
+//   P[i] - min(P[i - maxLen .. i - 1])
+// and a sliding-window minimum keeps that window's minimum as i advances.
+// Returns LLONG_MIN when no non-empty subarray fits (empty arr, maxLen <= 0).
+// Time: O(n), Space: O(n)
+long long maxSubarrayBounded(const std::vector<int>& arr, int maxLen) {
+    int n = arr.size();
+    MonotoneDeque<long long> window;
+    long long prefix = 0, best = LLONG_MIN;
+    if (maxLen <= 0) return best;
+    
+    window.push(0, 0);
+    for (int i = 1; i <= n; i++) {
+        prefix += arr[i - 1];
+        window.popBefore(i - maxLen);
+        best = std::max(best, prefix - window.best());
+        window.push(i, prefix);
+    }
+    return best;
+}
+
+// Split a non-negative array into k contiguous groups, minimizing the sum of
+// squared group sums (balanced partitioning, e.g. spreading work over k days)
+//   dp[g][i] = min over j < i of dp[g-1][j] + (P[i] - P[j])²
+// Squared group sums obey the quadrangle inequality, so the best last cut
+// only moves right as i grows: divide and conquer optimization
+// Time: O(k * n log n)
+long long minSquaredPartition(const std::vector<int>& arr, int k) {
+    int n = arr.size();
+    std::vector<long long> prefix(n + 1, 0);
+    for (int i = 0; i < n; i++) {
+        // Negative entries break the quadrangle inequality the split relies on
+        if (arr[i] < 0) throw std::runtime_error("minSquaredPartition: negative element");
+        prefix[i + 1] = prefix[i] + arr[i];
+    }
+    auto cost = [&prefix](int j, int i) {
+        long long sum = prefix[i] - prefix[j];
+        return sum * sum;
+    };
+    
+    std::vector<long long> dp(n + 1, DP_INF);
+    dp[0] = 0;
+    for (int g = 1; g <= k; g++) {
+        dp = divideConquerLayer(dp, cost);
+    }
+    return dp[n];
+}
+
 // Matrix multiplication using D&C (Strassen's approach concept)
 void printMatrix(const std::vector<std::vector<int>>& mat) {
     for (const auto& row : mat) {
@@ -93,40 +305,200 @@ void mergeSort(std::vector<int>& arr, int left, int right) {
 }
 
 // Count inversions using D&C
-long long mergeAndCount(std::vector<int>& arr, int left, int mid, int right) {
-    std::vector<int> temp(right - left + 1);
-    int i = left, j = mid + 1, k = 0;
+// Merge arr[left, mid) and arr[mid, right) through scratch, counting pairs
+// that cross the halves out of order. The caller owns scratch, so a whole
+// sort makes one allocation instead of one per merge.
+long long mergeAndCount(int* arr, int* scratch, size_t left, size_t mid, size_t right) {
+    size_t i = left, j = mid, k = left;
     long long invCount = 0;
     
-    while (i <= mid && j <= right) {
+    while (i < mid && j < right) {
         if (arr[i] <= arr[j]) {
-            temp[k++] = arr[i++];
+            scratch[k++] = arr[i++];
         } else {
-            temp[k++] = arr[j++];
-            invCount += (mid - i + 1);
+            scratch[k++] = arr[j++];
+            invCount += mid - i;
         }
     }
     
-    while (i <= mid) temp[k++] = arr[i++];
-    while (j <= right) temp[k++] = arr[j++];
+    while (i < mid) scratch[k++] = arr[i++];
+    while (j < right) scratch[k++] = arr[j++];
     
-    for (int i = 0; i < temp.size(); i++) {
-        arr[left + i] = temp[i];
-    }
+    std::copy(scratch + left, scratch + right, arr + left);
     
     return invCount;
 }
 
+// Sorts arr[lo, hi) and returns its inversions. Halves are independent until
+// their merge, so while the thread budget lasts the left half runs as a task.
+long long countInversionsTask(int* arr, int* scratch, size_t lo, size_t hi, int threads) {
+    if (hi - lo < 2) return 0;
+    
+    size_t mid = lo + (hi - lo) / 2;
+    long long leftCount, rightCount;
+    if (threads > 1 && hi - lo >= PARALLEL_CUTOFF) {
+        std::thread worker([&] { leftCount = countInversionsTask(arr, scratch, lo, mid, threads / 2); });
+        rightCount = countInversionsTask(arr, scratch, mid, hi, threads - threads / 2);
+        worker.join();
+    } else {
+        leftCount = countInversionsTask(arr, scratch, lo, mid, 1);
+        rightCount = countInversionsTask(arr, scratch, mid, hi, 1);
+    }
+    
+    return leftCount + rightCount + mergeAndCount(arr, scratch, lo, mid, hi);
+}
+
+// Inversions of arr[left..right]; sorts that range
 long long countInversions(std::vector<int>& arr, int left, int right) {
+    if (left >= right) return 0;
+    std::vector<int> scratch(arr.size());
+    return countInversionsTask(arr.data(), scratch.data(), left, right + 1, 1);
+}
+
+// Parallel mode. The final merges stay serial, so speedup is bounded by the
+// O(n) top-level merge.
+// Time: O(n log n / threads + n), Space: O(n)
+long long countInversionsParallel(std::vector<int>& arr, int threads = 0) {
+    if (threads <= 0) {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    std::vector<int> scratch(arr.size());
+    return countInversionsTask(arr.data(), scratch.data(), 0, arr.size(), threads);
+}
+
+// Fenwick tree of counts over values 0..size-1
+class FenwickCounter {
+private:
+    std::vector<long long> tree;
+
+public:
+    explicit FenwickCounter(size_t size) : tree(size + 1, 0) {}
+    
+    void add(size_t value) {
+        for (size_t i = value + 1; i < tree.size(); i += i & (~i + 1)) {
+            tree[i]++;
+        }
+    }
+    
+    // How many added values are <= value
+    long long countUpTo(size_t value) const {
+        long long count = 0;
+        for (size_t i = value + 1; i > 0; i -= i & (~i + 1)) {
+            count += tree[i];
+        }
+        return count;
+    }
+};
+
+// Fenwick mode
+// Scan left to right; each element's inversions are the earlier elements
+// greater than it. Values are replaced by their ranks first, so memory is
+// O(distinct values) and arr is left untouched.
+// Time: O(n log n), Space: O(n)
+long long countInversionsFenwick(const std::vector<int>& arr) {
+    std::vector<int> values = arr;
+    std::sort(values.begin(), values.end());
+    values.erase(std::unique(values.begin(), values.end()), values.end());
+    
+    FenwickCounter counter(values.size());
     long long invCount = 0;
+    for (size_t i = 0; i < arr.size(); i++) {
+        size_t rank = std::lower_bound(values.begin(), values.end(), arr[i]) - values.begin();
+        invCount += i - counter.countUpTo(rank);
+        counter.add(rank);
+    }
+    return invCount;
+}
+
+// Streaming from disk
+// An array of 10^9 ints is 4 GB, so these read a file of raw native int32
+// values a chunk at a time and keep only one chunk in memory.
+
+// Reads up to chunk.size() values; returns how many were read
+size_t readChunk(std::ifstream& in, std::vector<int>& chunk) {
+    in.read(reinterpret_cast<char*>(chunk.data()), chunk.size() * sizeof(int));
+    return in.gcount() / sizeof(int);
+}
+
+std::ifstream openStream(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) {
+        throw std::runtime_error("cannot open " + path);
+    }
+    return in;
+}
+
+// Each chunk reduces to a summary in parallel; summaries fold left to right.
+// Time: O(n / threads), Space: O(chunkSize)
+long long maxSubarrayStream(const std::string& path, size_t chunkSize = 1 << 24, int threads = 0) {
+    if (threads <= 0) {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    std::ifstream in = openStream(path);
+    std::vector<int> chunk(chunkSize);
     
-    if (left < right) {
-        int mid = left + (right - left) / 2;
-        invCount += countInversions(arr, left, mid);
-        invCount += countInversions(arr, mid + 1, right);
-        invCount += mergeAndCount(arr, left, mid, right);
+    bool any = false;
+    SegmentSummary total{};
+    while (size_t count = readChunk(in, chunk)) {
+        SegmentSummary part = maxSubarrayTask(chunk.data(), 0, count, threads);
+        total = any ? combineSegments(total, part) : part;
+        any = true;
+    }
+    if (!any) {
+        throw std::runtime_error(path + " is empty");
+    }
+    return total.best;
+}
+
+// Values must lie in [0, valueRange). Inversions inside a chunk come from the
+// parallel merge sort; inversions against earlier chunks are read from a
+// Fenwick tree over the value range, queried by all threads at once since
+// nothing writes it until the chunk is done.
+// Time: O(n log n / threads + n log(valueRange)), Space: O(chunkSize + valueRange)
+long long countInversionsStream(const std::string& path, int valueRange,
+                                size_t chunkSize = 1 << 24, int threads = 0) {
+    if (threads <= 0) {
+        threads = std::max(1u, std::thread::hardware_concurrency());
     }
+    std::ifstream in = openStream(path);
+    std::vector<int> chunk(chunkSize), scratch(chunkSize);
+    FenwickCounter seenValues(valueRange);
+    long long seen = 0, invCount = 0;
     
+    while (size_t count = readChunk(in, chunk)) {
+        for (size_t i = 0; i < count; i++) {
+            if (chunk[i] < 0 || chunk[i] >= valueRange) {
+                throw std::runtime_error("value out of range in " + path);
+            }
+        }
+        
+        // Earlier chunks' values greater than each element
+        int workers = count >= PARALLEL_CUTOFF ? threads : 1;
+        size_t slice = (count + workers - 1) / workers;
+        std::vector<long long> crossing(workers, 0);
+        std::vector<std::thread> pool;
+        for (int t = 0; t < workers; t++) {
+            pool.emplace_back([&, t] {
+                size_t from = t * slice, to = std::min(count, from + slice);
+                for (size_t i = from; i < to; i++) {
+                    crossing[t] += seen - seenValues.countUpTo(chunk[i]);
+                }
+            });
+        }
+        for (std::thread& worker : pool) {
+            worker.join();
+        }
+        for (long long part : crossing) {
+            invCount += part;
+        }
+        
+        // Inside the chunk; sorting it does not change what gets added below
+        invCount += countInversionsTask(chunk.data(), scratch.data(), 0, count, threads);
+        for (size_t i = 0; i < count; i++) {
+            seenValues.add(chunk[i]);
+        }
+        seen += count;
+    }
     return invCount;
 }
 
@@ -142,6 +514,49 @@ int main() {
     int maxSum = maxSubarrayDC(arr1, 0, arr1.size() - 1);
     std::cout << "Maximum subarray sum (D&C): " << maxSum << std::endl;
     
+    // Range queries with point updates
+    std::cout << "\n=== Range Max-Subarray Queries ===" << std::endl;
+    MaxSubarrayTree rangeTree(arr1);
+    std::cout << "Best in [0, 8]: " << rangeTree.query(0, 8) << std::endl;
+    std::cout << "Best in [0, 2]: " << rangeTree.query(0, 2) << std::endl;
+    std::cout << "Best in [6, 8]: " << rangeTree.query(6, 8) << std::endl;
+    rangeTree.update(7, 5);
+    std::cout << "After arr[7] = 5, best in [0, 8]: " << rangeTree.query(0, 8) << std::endl;
+    
+    std::vector<int> prices(1 << 20);
+    uint32_t seed = 99;
+    for (int& change : prices) {
+        seed = seed * 1103515245 + 12345;
+        change = (int)((seed >> 8) % 2001) - 1000;
+    }
+    MaxSubarrayTree priceTree(prices);
+    long long checksum = 0;
+    for (int q = 0; q < 1000000; q++) {
+        seed = seed * 1103515245 + 12345;
+        size_t l = (seed >> 4) % prices.size();
+        seed = seed * 1103515245 + 12345;
+        size_t r = (seed >> 4) % prices.size();
+        if (l > r) std::swap(l, r);
+        if (q % 10 == 0) {
+            priceTree.update(l, (int)(seed % 2001) - 1000);
+        }
+        checksum += priceTree.query(l, r);
+    }
+    std::cout << "10^6 queries with 10^5 updates on 2^20 prices, checksum: " << checksum << std::endl;
+    
+    // Sliding-window and D&C optimized recurrences
+    std::cout << "\n=== Optimized 1D/1D Recurrences ===" << std::endl;
+    std::vector<int> signal(5000), loads(2000);
+    for (int i = 0; i < 5000; i++) {
+        signal[i] = (i * 7919) % 201 - 100;
+    }
+    for (int i = 0; i < 2000; i++) {
+        loads[i] = 1 + (i * 104729) % 100;
+    }
+    std::cout << "Max subarray, length <= 2500 (deque O(n)): " << maxSubarrayBounded(signal, 2500) << std::endl;
+    std::cout << "2000 loads into 8 groups, min sum of squares (D&C O(kn log n)): "
+              << minSquaredPartition(loads, 8) << std::endl;
+    
     // Merge Sort
     std::cout << "\n=== Merge Sort ===" << std::endl;
     std::vector<int> arr2 = {12, 11, 13, 5, 6, 7};
@@ -164,6 +579,40 @@ int main() {
     
     long long inv = countInversions(arr3, 0, arr3.size() - 1);
     std::cout << "Number of inversions: " << inv << std::endl;
+    std::cout << "Number of inversions (Fenwick): " << countInversionsFenwick(arr3Copy) << std::endl;
+    
+    // Parallel and streaming modes
+    std::cout << "\n=== Parallel and Streaming ===" << std::endl;
+    const int VALUE_RANGE = 1000000;
+    std::vector<int> big(1 << 22);
+    uint32_t state = 2024;
+    for (int& x : big) {
+        state = state * 1103515245 + 12345;
+        x = (state >> 8) % VALUE_RANGE;
+    }
+    std::vector<int> centered = big;
+    for (int& x : centered) x -= VALUE_RANGE / 2;
+    
+    std::cout << "n = " << big.size() << std::endl;
+    std::cout << "Max subarray (D&C):      " << maxSubarrayDC(centered, 0, centered.size() - 1) << std::endl;
+    std::cout << "Max subarray (parallel): " << maxSubarrayParallel(centered) << std::endl;
+    std::cout << "Inversions (Fenwick):    " << countInversionsFenwick(big) << std::endl;
+    
+    // Write both arrays out and stream them back in 1M-element chunks
+    std::string path = (std::filesystem::temp_directory_path() / "dc_stream.bin").string();
+    {
+        std::ofstream out(path, std::ios::binary);
+        out.write(reinterpret_cast<const char*>(centered.data()), centered.size() * sizeof(int));
+    }
+    std::cout << "Max subarray (streamed): " << maxSubarrayStream(path, 1 << 20) << std::endl;
+    {
+        std::ofstream out(path, std::ios::binary);
+        out.write(reinterpret_cast<const char*>(big.data()), big.size() * sizeof(int));
+    }
+    std::cout << "Inversions (streamed):   " << countInversionsStream(path, VALUE_RANGE, 1 << 20) << std::endl;
+    std::filesystem::remove(path);
+    
+    std::cout << "Inversions (parallel):   " << countInversionsParallel(big) << std::endl;
     
     std::cout << "\nD&C Paradigm:" << std::endl;
     std::cout << "  1. Divide: Break problem into smaller subproblems" << std::endl;
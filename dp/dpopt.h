@@ -0,0 +1,233 @@
+#ifndef DPOPT_H
+#define DPOPT_H
+
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include <functional>
+#include <climits>
+
+// DP Optimizations for 1D/1D recurrences
+//   dp[i] = min over j < i of f(j) + cost(j, i)
+// is O(n²) as written. Three standard shapes of cost make it faster:
+//   - MonotoneDeque: j ranges over a sliding window and cost(j, i) splits into
+//     a j-part plus an i-part. O(n) total.
+//   - ConvexHullTrick / LiChaoTree: cost(j, i) = a(j) * x(i) + b(j), a line in
+//     x(i). The hull of lines answers each i in O(log n).
+//   - divideConquerLayer: the best j never moves left as i grows. O(n log n)
+//     per layer.
+
+// Large enough to mean "unreachable", small enough that adding two costs to
+// it does not overflow
+const long long DP_INF = LLONG_MAX / 4;
+
+// Monotone Deque
+// Sliding-window best (minimum with std::less, maximum with std::greater).
+// Values pushed later with a better-or-equal value make earlier ones useless,
+// so the deque stays sorted by value and the front is the window's best.
+// Every index is pushed and popped at most once: amortized O(1).
+template <typename T, typename Better = std::less<T>>
+class MonotoneDeque {
+private:
+    // Flat arrays with head and tail cursors instead of std::deque: the hot
+    // loop is a few compares, and clear() keeps the storage for the next window
+    std::vector<int> indices;
+    std::vector<T> values;
+    int head = 0, tail = 0;
+    Better better;
+
+public:
+    // Room for n pushes between clears, so push never reallocates
+    void reserve(int n) {
+        if ((int)indices.size() < n) {
+            indices.resize(n);
+            values.resize(n);
+        }
+    }
+    
+    void push(int index, const T& value) {
+        while (tail > head && !better(values[tail - 1], value)) {
+            tail--;
+        }
+        if (tail == (int)indices.size()) {
+            reserve(std::max(16, 2 * tail));
+        }
+        indices[tail] = index;
+        values[tail++] = value;
+    }
+    
+    // Drop indices that left the window
+    void popBefore(int index) {
+        while (head < tail && indices[head] < index) {
+            head++;
+        }
+    }
+    
+    bool empty() const { return head == tail; }
+    const T& best() const { return values[head]; }
+    int bestIndex() const { return indices[head]; }
+    
+    void clear() {
+        head = 0;
+        tail = 0;
+    }
+};
+
+// Convex Hull Trick (minimum)
+// Lines y = slope * x + intercept must arrive with non-increasing slopes, as
+// they do when the slope comes from a sorted key. Lines that are never the
+// minimum are dropped, leaving a lower envelope that queries binary search.
+// Add: amortized O(1), Query: O(log n)
+class ConvexHullTrick {
+private:
+    struct Line {
+        long long slope, intercept;
+        long long at(long long x) const { return slope * x + intercept; }
+    };
+    std::vector<Line> hull;
+    
+    // b is useless when a and c meet at or below it
+    static bool redundant(const Line& a, const Line& b, const Line& c) {
+        return (__int128)(c.intercept - a.intercept) * (a.slope - b.slope) <=
+               (__int128)(b.intercept - a.intercept) * (a.slope - c.slope);
+    }
+
+public:
+    void addLine(long long slope, long long intercept) {
+        Line line{slope, intercept};
+        if (!hull.empty() && hull.back().slope == slope) {
+            if (hull.back().intercept <= intercept) return;
+            hull.pop_back();
+        }
+        while (hull.size() >= 2 && redundant(hull[hull.size() - 2], hull.back(), line)) {
+            hull.pop_back();
+        }
+        hull.push_back(line);
+    }
+    
+    bool empty() const { return hull.empty(); }
+    
+    long long query(long long x) const {
+        // Along the envelope values fall, then rise; find the turn
+        int lo = 0, hi = hull.size() - 1;
+        while (lo < hi) {
+            int mid = (lo + hi) / 2;
+            if (hull[mid].at(x) <= hull[mid + 1].at(x)) {
+                hi = mid;
+            } else {
+                lo = mid + 1;
+            }
+        }
+        return hull[lo].at(x);
+    }
+};
+
+// Li Chao Tree (minimum)
+// Lines in any order, queries at any of a fixed set of x coordinates. Each
+// node keeps the line that wins at its midpoint; the loser can only win on
+// one side, so it moves down one child. Add: O(log n), Query: O(log n)
+class LiChaoTree {
+private:
+    struct Line {
+        long long slope, intercept;
+        long long at(long long x) const { return slope * x + intercept; }
+    };
+    std::vector<long long> xs;  // Sorted, distinct query coordinates
+    std::vector<Line> tree;
+    std::vector<bool> present;
+    
+    void insert(int node, int lo, int hi, Line line) {
+        while (true) {
+            if (!present[node]) {
+                tree[node] = line;
+                present[node] = true;
+                return;
+            }
+            int mid = (lo + hi) / 2;
+            Line& cur = tree[node];
+            bool winsLeft = line.at(xs[lo]) < cur.at(xs[lo]);
+            bool winsMid = line.at(xs[mid]) < cur.at(xs[mid]);
+            if (winsMid) std::swap(cur, line);
+            if (lo == hi) return;
+            if (winsLeft != winsMid) {
+                node = 2 * node;
+                hi = mid;
+            } else {
+                node = 2 * node + 1;
+                lo = mid + 1;
+            }
+        }
+    }
+
+public:
+    explicit LiChaoTree(std::vector<long long> coords) : xs(std::move(coords)) {
+        std::sort(xs.begin(), xs.end());
+        xs.erase(std::unique(xs.begin(), xs.end()), xs.end());
+        tree.resize(4 * std::max<size_t>(xs.size(), 1));
+        present.assign(tree.size(), false);
+    }
+    
+    void addLine(long long slope, long long intercept) {
+        if (xs.empty()) return;
+        insert(1, 0, xs.size() - 1, {slope, intercept});
+    }
+    
+    // x must be one of the coordinates given at construction; DP_INF if no
+    // line was added yet
+    long long query(long long x) const {
+        int pos = std::lower_bound(xs.begin(), xs.end(), x) - xs.begin();
+        long long best = DP_INF;
+        int node = 1, lo = 0, hi = xs.size() - 1;
+        while (present[node]) {
+            best = std::min(best, tree[node].at(x));
+            if (lo == hi) break;
+            int mid = (lo + hi) / 2;
+            if (pos <= mid) {
+                node = 2 * node;
+                hi = mid;
+            } else {
+                node = 2 * node + 1;
+                lo = mid + 1;
+            }
+        }
+        return best;
+    }
+};
+
+// Divide and Conquer Optimization
+// One layer of cur[i] = min over j < i of prev[j] + cost(j, i), for i >= 1.
+// Valid when the best j, opt(i), is non-decreasing in i, e.g. when cost obeys
+// the quadrangle inequality. Solving the middle i first bounds opt for both
+// halves, so each recursion level scans O(n) candidates.
+// Time: O(n log n) per layer
+template <typename Cost>
+void divideConquerLayer(const std::vector<long long>& prev, std::vector<long long>& cur,
+                        Cost cost, int lo, int hi, int optLo, int optHi) {
+    if (lo > hi) return;
+    int mid = (lo + hi) / 2;
+    long long best = DP_INF;
+    int bestJ = optLo;
+    
+    for (int j = optLo; j <= std::min(mid - 1, optHi); j++) {
+        if (prev[j] >= DP_INF) continue;
+        long long value = prev[j] + cost(j, mid);
+        if (value < best) {
+            best = value;
+            bestJ = j;
+        }
+    }
+    cur[mid] = best;
+    
+    divideConquerLayer(prev, cur, cost, lo, mid - 1, optLo, bestJ);
+    divideConquerLayer(prev, cur, cost, mid + 1, hi, bestJ, optHi);
+}
+
+template <typename Cost>
+std::vector<long long> divideConquerLayer(const std::vector<long long>& prev, Cost cost) {
+    int n = prev.size() - 1;
+    std::vector<long long> cur(n + 1, DP_INF);
+    divideConquerLayer(prev, cur, cost, 1, n, 0, n - 1);
+    return cur;
+}
+
+#endif
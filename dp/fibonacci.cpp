@@ -1,6 +1,7 @@
 #include <iostream>
 #include <vector>
 #include <chrono>
+#include "memo.h"
 
 // Fibonacci: Classic DP example
 // F(0) = 0, F(1) = 1, F(n) = F(n-1) + F(n-2)
@@ -16,19 +17,20 @@ int fibonacciRecursive(int n) {
 // 2. Memoization (Top-Down DP)
 // Time Complexity: O(n)
 // Space Complexity: O(n) for memo array + O(n) for recursion stack
-int fibonacciMemo(int n, std::vector<int>& memo) {
+int fibonacciMemo(int n, MemoCache<1, int>& memo) {
     if (n <= 1) return n;
     
-    if (memo[n] != -1) {
-        return memo[n];  // Return cached result
+    if (const int* cached = memo.find({n})) {
+        return *cached;  // Return cached result
     }
     
-    memo[n] = fibonacciMemo(n - 1, memo) + fibonacciMemo(n - 2, memo);
-    return memo[n];
+    int result = fibonacciMemo(n - 1, memo) + fibonacciMemo(n - 2, memo);
+    memo.store({n}, result);
+    return result;
 }
 
 int fibonacciMemoWrapper(int n) {
-    std::vector<int> memo(n + 1, -1);
+    MemoCache<1, int> memo({n + 1});
     return fibonacciMemo(n, memo);
 }
 
@@ -175,6 +177,15 @@ int main() {
     std::cout << "F(40) = " << fibonacciOptimized(40) << std::endl;
     std::cout << "F(50) = " << fibonacciMatrix(50) << std::endl;
     
+    // Cache metrics
+    MemoCache<1, int> memo({31});
+    fibonacciMemo(30, memo);
+    const MemoStats& stats = memo.stats();
+    std::cout << "\n=== Memo Cache (F(30)) ===" << std::endl;
+    std::cout << "Backend: " << (memo.dense() ? "dense" : "hash") << std::endl;
+    std::cout << "Hits: " << stats.hits << ", Misses: " << stats.misses
+              << ", Hit rate: " << stats.hitRate() << std::endl;
+    
     // Performance comparison
     benchmark(20);
     benchmark(35);
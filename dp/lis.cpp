@@ -2,6 +2,8 @@
 #include <vector>
 #include <string>
 #include <algorithm>
+#include <thread>
+#include <climits>
 
 // Longest Increasing Subsequence (LIS)
 // Find longest subsequence where elements are in increasing order
@@ -46,41 +48,61 @@ int lisBinarySearch(const std::vector<int>& arr) {
     return tails.size();
 }
 
-// Reconstruct LIS sequence
-std::vector<int> lisSequence(const std::vector<int>& arr) {
-    int n = arr.size();
-    if (n == 0) return {};
+// 3. Streaming LIS
+// Time: O(log n) per element, Space: O(n)
+// Elements arrive one at a time. tails[k] is the smallest value ending an
+// increasing subsequence of length k+1 (patience sorting), and each element
+// remembers the element ending the length-k run it extended, so the current
+// LIS can be read back at any moment.
+class StreamingLIS {
+private:
+    std::vector<int> values;
+    std::vector<int> parent;   // Index of the previous element in its best run
+    std::vector<int> tails;    // tails[k] = smallest tail of a run of length k+1
+    std::vector<int> tailIdx;  // Index of the element holding tails[k]
     
-    std::vector<int> dp(n, 1);
-    std::vector<int> parent(n, -1);
-    
-    for (int i = 1; i < n; i++) {
-        for (int j = 0; j < i; j++) {
-            if (arr[j] < arr[i] && dp[j] + 1 > dp[i]) {
-                dp[i] = dp[j] + 1;
-                parent[i] = j;
-            }
+public:
+    void push(int x) {
+        int idx = values.size();
+        values.push_back(x);
+        
+        // Strictly increasing: replace the first tail >= x
+        int k = std::lower_bound(tails.begin(), tails.end(), x) - tails.begin();
+        parent.push_back(k > 0 ? tailIdx[k - 1] : -1);
+        if (k == (int)tails.size()) {
+            tails.push_back(x);
+            tailIdx.push_back(idx);
+        } else {
+            tails[k] = x;
+            tailIdx[k] = idx;
         }
     }
     
-    // Find index with maximum LIS length
-    int maxIdx = 0;
-    for (int i = 1; i < n; i++) {
-        if (dp[i] > dp[maxIdx]) {
-            maxIdx = i;
-        }
+    int length() const {
+        return tails.size();
     }
     
-    // Reconstruct sequence
-    std::vector<int> lis;
-    int idx = maxIdx;
-    while (idx != -1) {
-        lis.push_back(arr[idx]);
-        idx = parent[idx];
+    // Time: O(LIS length)
+    std::vector<int> sequence() const {
+        std::vector<int> lis;
+        int idx = tailIdx.empty() ? -1 : tailIdx.back();
+        while (idx != -1) {
+            lis.push_back(values[idx]);
+            idx = parent[idx];
+        }
+        std::reverse(lis.begin(), lis.end());
+        return lis;
     }
-    
-    std::reverse(lis.begin(), lis.end());
-    return lis;
+};
+
+// Reconstruct LIS sequence
+// Time: O(n log n), Space: O(n)
+std::vector<int> lisSequence(const std::vector<int>& arr) {
+    StreamingLIS stream;
+    for (int num : arr) {
+        stream.push(num);
+    }
+    return stream.sequence();
 }
 
 // Longest Decreasing Subsequence
@@ -93,65 +115,82 @@ int longestDecreasingSubsequence(const std::vector<int>& arr) {
 }
 
 // Number of LIS
-// Time: O(n²), Space: O(n)
-int numberOfLIS(const std::vector<int>& arr) {
+// Time: O(n log n), Space: O(n)
+// A Fenwick tree over compressed values holds, for every prefix of values, the
+// best (length, count) pair among elements seen so far. Element i asks for the
+// best pair over values < arr[i] and extends it by one.
+struct LengthCount {
+    int len;
+    long long count;
+};
+
+LengthCount combine(const LengthCount& a, const LengthCount& b) {
+    if (a.len != b.len) return a.len > b.len ? a : b;
+    return {a.len, a.count + b.count};
+}
+
+long long numberOfLIS(const std::vector<int>& arr) {
     int n = arr.size();
     if (n == 0) return 0;
     
-    std::vector<int> dp(n, 1);      // Length of LIS ending at i
-    std::vector<int> count(n, 1);   // Count of LIS ending at i
+    std::vector<int> sorted(arr);
+    std::sort(sorted.begin(), sorted.end());
+    sorted.erase(std::unique(sorted.begin(), sorted.end()), sorted.end());
+    int m = sorted.size();
     
-    for (int i = 1; i < n; i++) {
-        for (int j = 0; j < i; j++) {
-            if (arr[j] < arr[i]) {
-                if (dp[j] + 1 > dp[i]) {
-                    dp[i] = dp[j] + 1;
-                    count[i] = count[j];
-                } else if (dp[j] + 1 == dp[i]) {
-                    count[i] += count[j];
-                }
-            }
-        }
-    }
+    std::vector<LengthCount> tree(m + 1, {0, 0});
+    LengthCount best = {0, 0};
     
-    int maxLen = *std::max_element(dp.begin(), dp.end());
-    int result = 0;
-    
-    for (int i = 0; i < n; i++) {
-        if (dp[i] == maxLen) {
-            result += count[i];
+    for (int x : arr) {
+        int rank = std::lower_bound(sorted.begin(), sorted.end(), x) - sorted.begin();
+        
+        // Best pair over ranks [0, rank)
+        LengthCount prefix = {0, 1};  // Empty run: one way to start
+        for (int i = rank; i > 0; i -= i & -i) {
+            prefix = combine(prefix, tree[i]);
+        }
+        
+        LengthCount here = {prefix.len + 1, prefix.count};
+        for (int i = rank + 1; i <= m; i += i & -i) {
+            tree[i] = combine(tree[i], here);
         }
+        best = combine(best, here);
     }
     
-    return result;
+    return best.count;
 }
 
 // Longest Bitonic Subsequence
 // Sequence that first increases then decreases
-// Time: O(n²), Space: O(n)
+// Time: O(n log n), Space: O(n)
+// lis[i] is the patience-sorting position of arr[i] plus one, i.e. the
+// longest increasing run ending at i; lds[i] is the same from the right.
+std::vector<int> lisEndingAt(const std::vector<int>& arr) {
+    std::vector<int> tails;
+    std::vector<int> ending(arr.size());
+    for (size_t i = 0; i < arr.size(); i++) {
+        auto it = std::lower_bound(tails.begin(), tails.end(), arr[i]);
+        ending[i] = it - tails.begin() + 1;
+        if (it == tails.end()) {
+            tails.push_back(arr[i]);
+        } else {
+            *it = arr[i];
+        }
+    }
+    return ending;
+}
+
 int longestBitonicSubsequence(const std::vector<int>& arr) {
     int n = arr.size();
     if (n == 0) return 0;
     
     // LIS from left
-    std::vector<int> lis(n, 1);
-    for (int i = 1; i < n; i++) {
-        for (int j = 0; j < i; j++) {
-            if (arr[j] < arr[i]) {
-                lis[i] = std::max(lis[i], lis[j] + 1);
-            }
-        }
-    }
+    std::vector<int> lis = lisEndingAt(arr);
     
     // LDS from right
-    std::vector<int> lds(n, 1);
-    for (int i = n - 2; i >= 0; i--) {
-        for (int j = n - 1; j > i; j--) {
-            if (arr[j] < arr[i]) {
-                lds[i] = std::max(lds[i], lds[j] + 1);
-            }
-        }
-    }
+    std::vector<int> reversed(arr.rbegin(), arr.rend());
+    std::vector<int> lds = lisEndingAt(reversed);
+    std::reverse(lds.begin(), lds.end());
     
     // Maximum bitonic length
     int maxLen = 0;
@@ -162,6 +201,137 @@ int longestBitonicSubsequence(const std::vector<int>& arr) {
     return maxLen;
 }
 
+// 4. Parallel Divide and Conquer
+// Time: O(n log² n) work, Space: O(n)
+// dp[i] = 1 + max dp[j] over j < i with arr[j] < arr[i]. CDQ divide and conquer
+// on the index: finish the left half, let every left element contribute to the
+// right half, then finish the right half. A contribution sorts the left half by
+// value into a running maximum and answers each right element with a binary
+// search. The sort runs in per-thread chunks and the answers are independent,
+// so both spread across threads. Small ranges fall back to a serial Fenwick pass.
+class ParallelLIS {
+private:
+    static const int BASE = 1 << 14;
+    const std::vector<int>& arr;
+    std::vector<int> dp;
+    std::vector<std::pair<int, int>> scratch;  // (value, dp) of a left half, reused
+    int threads;
+    
+    // Run fn(from, to) on contiguous slices of [begin, end)
+    template <typename Fn>
+    void parallelFor(int begin, int end, Fn fn) {
+        int total = end - begin;
+        if (threads <= 1 || total < BASE) {
+            fn(begin, end);
+            return;
+        }
+        int chunk = (total + threads - 1) / threads;
+        std::vector<std::thread> pool;
+        for (int from = begin; from < end; from += chunk) {
+            pool.emplace_back(fn, from, std::min(end, from + chunk));
+        }
+        for (std::thread& worker : pool) {
+            worker.join();
+        }
+    }
+    
+    void solveBlock(int lo, int hi) {
+        std::vector<int> sorted(arr.begin() + lo, arr.begin() + hi);
+        std::sort(sorted.begin(), sorted.end());
+        sorted.erase(std::unique(sorted.begin(), sorted.end()), sorted.end());
+        std::vector<int> tree(sorted.size() + 1, 0);  // Prefix max of dp by value
+        
+        for (int i = lo; i < hi; i++) {
+            int rank = std::lower_bound(sorted.begin(), sorted.end(), arr[i]) - sorted.begin();
+            int best = 0;
+            for (int k = rank; k > 0; k -= k & -k) best = std::max(best, tree[k]);
+            dp[i] = std::max(dp[i], best + 1);
+            for (int k = rank + 1; k <= (int)sorted.size(); k += k & -k) {
+                tree[k] = std::max(tree[k], dp[i]);
+            }
+        }
+    }
+    
+    void contribute(int lo, int mid, int hi) {
+        int m = mid - lo;
+        std::pair<int, int>* left = scratch.data();
+        for (int j = lo; j < mid; j++) {
+            left[j - lo] = {arr[j], dp[j]};
+        }
+        
+        // Sort chunks in parallel, then merge them pairwise
+        int chunk = threads > 1 && m >= BASE ? (m + threads - 1) / threads : m;
+        parallelFor(0, m, [left, chunk](int from, int to) {
+            for (int c = from; c < to; c += chunk) {
+                std::sort(left + c, left + std::min(to, c + chunk));
+            }
+        });
+        for (int width = chunk; width < m; width *= 2) {
+            for (int c = 0; c + width < m; c += 2 * width) {
+                std::inplace_merge(left + c, left + c + width, left + std::min(m, c + 2 * width));
+            }
+        }
+        
+        // Running maximum of dp in value order
+        for (int k = 1; k < m; k++) {
+            left[k].second = std::max(left[k].second, left[k - 1].second);
+        }
+        
+        parallelFor(mid, hi, [this, left, m](int from, int to) {
+            for (int i = from; i < to; i++) {
+                // Left elements with value < arr[i]
+                int k = std::lower_bound(left, left + m, std::make_pair(arr[i], INT_MIN)) - left;
+                if (k > 0) dp[i] = std::max(dp[i], left[k - 1].second + 1);
+            }
+        });
+    }
+    
+    void solve(int lo, int hi) {
+        if (hi - lo <= BASE) {
+            solveBlock(lo, hi);
+            return;
+        }
+        int mid = lo + (hi - lo) / 2;
+        solve(lo, mid);
+        contribute(lo, mid, hi);
+        solve(mid, hi);
+    }
+    
+public:
+    ParallelLIS(const std::vector<int>& input, int threadCount)
+        : arr(input), dp(input.size(), 1), scratch(input.size() / 2 + 1), threads(threadCount) {
+        if (threads <= 0) {
+            threads = std::max(1u, std::thread::hardware_concurrency());
+        }
+    }
+    
+    int length() {
+        if (arr.empty()) return 0;
+        solve(0, arr.size());
+        return *std::max_element(dp.begin(), dp.end());
+    }
+    
+    // Walk back from the end picking the latest element of each length.
+    // Call after length(). Time: O(n)
+    std::vector<int> sequence() const {
+        int need = dp.empty() ? 0 : *std::max_element(dp.begin(), dp.end());
+        std::vector<int> lis;
+        for (int i = arr.size() - 1; i >= 0 && need > 0; i--) {
+            if (dp[i] == need && (lis.empty() || arr[i] < lis.back())) {
+                lis.push_back(arr[i]);
+                need--;
+            }
+        }
+        std::reverse(lis.begin(), lis.end());
+        return lis;
+    }
+};
+
+int lisParallel(const std::vector<int>& arr, int threads = 0) {
+    ParallelLIS solver(arr, threads);
+    return solver.length();
+}
+
 void printArray(const std::vector<int>& arr, const std::string& name) {
     std::cout << name << ": ";
     for (int x : arr) {
@@ -178,53 +348,78 @@ int main() {
     // Example 1
     std::vector<int> arr1 = {10, 9, 2, 5, 3, 7, 101, 18};
     std::cout << "\n=== Example 1 ===" << std::endl;
-    printArray(arr1, \"Array\");
-    std::cout << \"LIS length (DP): \" << lisDP(arr1) << std::endl;
-    std::cout << \"LIS length (Binary Search): \" << lisBinarySearch(arr1) << std::endl;
+    printArray(arr1, "Array");
+    std::cout << "LIS length (DP): " << lisDP(arr1) << std::endl;
+    std::cout << "LIS length (Binary Search): " << lisBinarySearch(arr1) << std::endl;
     
     std::vector<int> lis = lisSequence(arr1);
-    printArray(lis, \"LIS sequence\");
+    printArray(lis, "LIS sequence");
     
     // Example 2
     std::vector<int> arr2 = {0, 8, 4, 12, 2, 10, 6, 14, 1, 9, 5, 13, 3, 11, 7, 15};
-    std::cout << \"\n=== Example 2 ===" << std::endl;
-    printArray(arr2, \"Array\");
-    std::cout << \"LIS length: \" << lisBinarySearch(arr2) << std::endl;
+    std::cout << "\n=== Example 2 ===" << std::endl;
+    printArray(arr2, "Array");
+    std::cout << "LIS length: " << lisBinarySearch(arr2) << std::endl;
     
     lis = lisSequence(arr2);
-    printArray(lis, \"LIS sequence\");
+    printArray(lis, "LIS sequence");
     
     // Number of LIS
     std::vector<int> arr3 = {1, 3, 5, 4, 7};
-    std::cout << \"\n=== Number of LIS ===" << std::endl;
-    printArray(arr3, \"Array\");
-    std::cout << \"LIS length: \" << lisDP(arr3) << std::endl;
-    std::cout << \"Number of LIS: \" << numberOfLIS(arr3) << std::endl;
+    std::cout << "\n=== Number of LIS ===" << std::endl;
+    printArray(arr3, "Array");
+    std::cout << "LIS length: " << lisDP(arr3) << std::endl;
+    std::cout << "Number of LIS: " << numberOfLIS(arr3) << std::endl;
     
     // Longest Bitonic Subsequence
     std::vector<int> arr4 = {1, 11, 2, 10, 4, 5, 2, 1};
-    std::cout << \"\n=== Longest Bitonic Subsequence ===" << std::endl;
-    printArray(arr4, \"Array\");
-    std::cout << \"Bitonic length: \" << longestBitonicSubsequence(arr4) << std::endl;
+    std::cout << "\n=== Longest Bitonic Subsequence ===" << std::endl;
+    printArray(arr4, "Array");
+    std::cout << "Bitonic length: " << longestBitonicSubsequence(arr4) << std::endl;
     // Expected: 1,11,10,5,2,1 or 1,2,10,5,2,1 (length 6)
     
     // Longest Decreasing Subsequence
     std::vector<int> arr5 = {10, 9, 2, 5, 3, 7, 101, 4};
-    std::cout << \"\n=== Longest Decreasing Subsequence ===" << std::endl;
-    printArray(arr5, \"Array\");
-    std::cout << \"LDS length: \" << longestDecreasingSubsequence(arr5) << std::endl;
-    
-    std::cout << \"\n=== Key Insights ===" << std::endl;
-    std::cout << \"1. DP Recurrence: dp[i] = max(dp[j] + 1) for all j < i where arr[j] < arr[i]\" << std::endl;
-    std::cout << \"2. Binary search uses patience sorting concept\" << std::endl;
-    std::cout << \"3. tails[i] = smallest ending element of LIS of length i+1\" << std::endl;
-    std::cout << \"4. Bitonic = LIS + LDS (increasing then decreasing)\" << std::endl;
-    
-    std::cout << \"\n=== Applications ===" << std::endl;
-    std::cout << \"1. Stock trading (buy low, sell high sequence)\" << std::endl;
-    std::cout << \"2. Box stacking problems\" << std::endl;
-    std::cout << \"3. Building bridges (matching pairs)\" << std::endl;
-    std::cout << \"4. Patience sorting card game\" << std::endl;
+    std::cout << "\n=== Longest Decreasing Subsequence ===" << std::endl;
+    printArray(arr5, "Array");
+    std::cout << "LDS length: " << longestDecreasingSubsequence(arr5) << std::endl;
+    
+    // Streaming: the LIS is available after every element
+    std::cout << "\n=== Streaming LIS ===" << std::endl;
+    StreamingLIS stream;
+    for (int x : arr1) {
+        stream.push(x);
+        std::cout << "push " << x << " -> length " << stream.length() << std::endl;
+    }
+    printArray(stream.sequence(), "Current LIS");
+    
+    // Parallel divide and conquer on a large array
+    std::vector<int> big(2000000);
+    uint32_t state = 7;
+    for (int& x : big) {
+        state = state * 1664525 + 1013904223;
+        x = state >> 8;
+    }
+    std::cout << "\n=== Parallel LIS (2,000,000 elements) ===" << std::endl;
+    std::cout << "Patience sorting: " << lisBinarySearch(big) << std::endl;
+    ParallelLIS parallel(big, 4);
+    std::cout << "Parallel D&C: " << parallel.length() << std::endl;
+    std::vector<int> bigLis = parallel.sequence();
+    std::cout << "Reconstructed length: " << bigLis.size()
+              << (std::is_sorted(bigLis.begin(), bigLis.end()) ? " (increasing)" : " (NOT increasing)")
+              << std::endl;
+    
+    std::cout << "\n=== Key Insights ===" << std::endl;
+    std::cout << "1. DP Recurrence: dp[i] = max(dp[j] + 1) for all j < i where arr[j] < arr[i]" << std::endl;
+    std::cout << "2. Binary search uses patience sorting concept" << std::endl;
+    std::cout << "3. tails[i] = smallest ending element of LIS of length i+1" << std::endl;
+    std::cout << "4. Bitonic = LIS + LDS (increasing then decreasing)" << std::endl;
+    
+    std::cout << "\n=== Applications ===" << std::endl;
+    std::cout << "1. Stock trading (buy low, sell high sequence)" << std::endl;
+    std::cout << "2. Box stacking problems" << std::endl;
+    std::cout << "3. Building bridges (matching pairs)" << std::endl;
+    std::cout << "4. Patience sorting card game" << std::endl;
     
     return 0;
 }
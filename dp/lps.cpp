@@ -2,6 +2,8 @@
 #include <vector>
 #include <string>
 #include <algorithm>
+#include <utility>
+#include <cstdint>
 
 // Longest Palindromic Subsequence
 // Time Complexity: O(n²)
@@ -33,52 +35,280 @@ int longestPalindromicSubsequence(const std::string& s) {
     return dp[0][n-1];
 }
 
+// Bit-parallel Longest Palindromic Subsequence
+// Time: O(n² / 64), Space: O(n / 64 + alphabet * n / 64)
+// LPS(s) = LCS(s, reverse(s)). Hyyrö's bit-vector LCS keeps one row of the
+// LCS table as a bit vector V over reverse(s) (a 0 bit marks where the row
+// value steps up) and advances a whole row per character of s with
+//   U = V & match[c];  V = (V + U) | (V & ~match[c])
+// so 64 cells move per word operation. LCS = n - popcount(V).
+int longestPalindromicSubsequenceBitParallel(const std::string& s) {
+    int n = s.length();
+    if (n == 0) return 0;
+    int words = (n + 63) / 64;
+    
+    // match[c] has bit j set when reverse(s)[j] == c
+    std::vector<std::vector<uint64_t>> match(256);
+    for (int j = 0; j < n; j++) {
+        unsigned char c = s[n - 1 - j];
+        if (match[c].empty()) match[c].assign(words, 0);
+        match[c][j / 64] |= uint64_t(1) << (j % 64);
+    }
+    
+    std::vector<uint64_t> V(words, ~uint64_t(0));
+    for (int i = 0; i < n; i++) {
+        const std::vector<uint64_t>& M = match[(unsigned char)s[i]];
+        uint64_t carry = 0;
+        for (int w = 0; w < words; w++) {
+            uint64_t u = V[w] & M[w];
+            uint64_t rest = V[w] & ~M[w];
+            uint64_t sum = V[w] + u;
+            uint64_t carryOut = sum < V[w];
+            sum += carry;
+            carryOut |= sum < carry;
+            carry = carryOut;
+            V[w] = sum | rest;
+        }
+    }
+    
+    // Bits past n in the last word never see a match and stay set
+    int ones = 0;
+    for (uint64_t w : V) ones += __builtin_popcountll(w);
+    return n - (ones - (words * 64 - n));
+}
+
+// Manacher's Algorithm
+// Time: O(n), Space: O(n)
+// odd[i]  = number of palindromes centered at i, so s[i-odd[i]+1 .. i+odd[i]-1]
+//           is the longest one there
+// even[i] = number of palindromes centered between i-1 and i, so
+//           s[i-even[i] .. i+even[i]-1] is the longest one there
+// The rightmost palindrome [l, r] found so far lets each new center start
+// from its mirror's radius instead of zero, and r only moves right.
+struct PalindromeRadii {
+    std::vector<int> odd;
+    std::vector<int> even;
+};
+
+PalindromeRadii manacher(const std::string& s) {
+    int n = s.length();
+    PalindromeRadii radii{std::vector<int>(n), std::vector<int>(n)};
+    
+    for (int i = 0, l = 0, r = -1; i < n; i++) {
+        int k = (i > r) ? 1 : std::min(radii.odd[l + r - i], r - i + 1);
+        while (i - k >= 0 && i + k < n && s[i - k] == s[i + k]) {
+            k++;
+        }
+        radii.odd[i] = k;
+        if (i + k - 1 > r) {
+            l = i - k + 1;
+            r = i + k - 1;
+        }
+    }
+    
+    for (int i = 0, l = 0, r = -1; i < n; i++) {
+        int k = (i > r) ? 0 : std::min(radii.even[l + r - i + 1], r - i + 1);
+        while (i - k - 1 >= 0 && i + k < n && s[i - k - 1] == s[i + k]) {
+            k++;
+        }
+        radii.even[i] = k;
+        if (i + k - 1 > r) {
+            l = i - k;
+            r = i + k - 1;
+        }
+    }
+    
+    return radii;
+}
+
 // Longest Palindromic Substring
-// Time: O(n²), Space: O(n²)
+// Time: O(n), Space: O(n)
 std::string longestPalindromicSubstring(const std::string& s) {
     int n = s.length();
-    if (n == 0) return \"\";
+    if (n == 0) return "";
     
-    std::vector<std::vector<bool>> dp(n, std::vector<bool>(n, false));
+    PalindromeRadii radii = manacher(s);
     int maxLen = 1, start = 0;
+    for (int i = 0; i < n; i++) {
+        if (2 * radii.odd[i] - 1 > maxLen) {
+            maxLen = 2 * radii.odd[i] - 1;
+            start = i - radii.odd[i] + 1;
+        }
+        if (2 * radii.even[i] > maxLen) {
+            maxLen = 2 * radii.even[i];
+            start = i - radii.even[i];
+        }
+    }
     
-    // Single characters
-    for (int i = 0; i < n; i++) dp[i][i] = true;
+    return s.substr(start, maxLen);
+}
+
+// Count palindromic substrings (with repetition)
+// Time: O(n) - every radius counts one palindrome per step
+long long countPalindromicSubstrings(const std::string& s) {
+    PalindromeRadii radii = manacher(s);
+    long long total = 0;
+    for (size_t i = 0; i < s.length(); i++) {
+        total += radii.odd[i] + radii.even[i];
+    }
+    return total;
+}
+
+// Palindromic Tree (Eertree)
+// Time: O(n * alphabet) worst case to build, Space: O(n)
+// One node per distinct palindrome (a string has at most n), plus two roots:
+// length -1 (parent of odd palindromes) and length 0 (parent of even ones).
+// suffixLink points to the longest proper palindromic suffix. Adding a
+// character walks suffix links from the longest palindromic suffix of the
+// prefix until the new character can wrap around it.
+class PalindromicTree {
+private:
+    struct Node {
+        int len;
+        int suffixLink;
+        long long occurrences;  // Times this palindrome ends a prefix as its longest
+        std::vector<std::pair<char, int>> next;  // Small alphabets: linear scan
+    };
+    
+    std::string text;
+    std::vector<Node> nodes;
+    int last;  // Longest palindromic suffix of the text so far
     
-    // Two characters
-    for (int i = 0; i < n-1; i++) {
-        if (s[i] == s[i+1]) {
-            dp[i][i+1] = true;
-            start = i;
-            maxLen = 2;
+    int child(int v, char c) const {
+        for (const auto& [ch, to] : nodes[v].next) {
+            if (ch == c) return to;
         }
+        return -1;
     }
     
-    // Longer substrings
-    for (int len = 3; len <= n; len++) {
-        for (int i = 0; i <= n - len; i++) {
-            int j = i + len - 1;
-            if (s[i] == s[j] && dp[i+1][j-1]) {
-                dp[i][j] = true;
-                if (len > maxLen) {
-                    start = i;
-                    maxLen = len;
-                }
-            }
+    // Walk suffix links until s[pos - len - 1] == s[pos]
+    int findExtendable(int v, int pos) const {
+        while (true) {
+            int before = pos - nodes[v].len - 1;
+            if (before >= 0 && text[before] == text[pos]) return v;
+            v = nodes[v].suffixLink;
         }
     }
+
+public:
+    PalindromicTree() : last(1) {
+        nodes.push_back({-1, 0, 0, {}});  // Root of odd palindromes
+        nodes.push_back({0, 0, 0, {}});   // Root of even palindromes
+    }
     
-    return s.substr(start, maxLen);
+    // Returns true when the character created a new distinct palindrome
+    bool add(char c) {
+        text.push_back(c);
+        int pos = text.size() - 1;
+        
+        int v = findExtendable(last, pos);
+        int existing = child(v, c);
+        if (existing != -1) {
+            last = existing;
+            nodes[last].occurrences++;
+            return false;
+        }
+        
+        Node node{nodes[v].len + 2, 1, 1, {}};
+        if (node.len > 1) {
+            int u = findExtendable(nodes[v].suffixLink, pos);
+            node.suffixLink = child(u, c);
+        }
+        nodes.push_back(node);
+        last = nodes.size() - 1;
+        nodes[v].next.push_back({c, last});
+        return true;
+    }
+    
+    int distinctPalindromes() const {
+        return nodes.size() - 2;
+    }
+    
+    // Every distinct palindrome with how often it occurs in the text.
+    // A palindrome occurs once for each time it or a palindrome it is a suffix
+    // of was the longest palindromic suffix, so counts flow down suffix links.
+    // Nodes are created longer-after-their-suffix-link, so reverse creation
+    // order is a valid processing order.
+    std::vector<std::pair<std::string, long long>> palindromeCounts() const {
+        std::vector<long long> count(nodes.size());
+        for (size_t v = 0; v < nodes.size(); v++) {
+            count[v] = nodes[v].occurrences;
+        }
+        for (size_t v = nodes.size() - 1; v >= 2; v--) {
+            count[nodes[v].suffixLink] += count[v];
+        }
+        
+        // Rebuild each palindrome's text from its first end position
+        std::vector<std::pair<std::string, long long>> result;
+        std::vector<int> end(nodes.size(), -1);
+        int v = 1;
+        for (size_t pos = 0; pos < text.size(); pos++) {
+            v = findExtendable(v, pos);
+            v = child(v, text[pos]);
+            for (int u = v; u >= 2 && end[u] == -1; u = nodes[u].suffixLink) {
+                end[u] = pos;
+            }
+        }
+        for (size_t u = 2; u < nodes.size(); u++) {
+            result.push_back({text.substr(end[u] - nodes[u].len + 1, nodes[u].len), count[u]});
+        }
+        return result;
+    }
+};
+
+int countDistinctPalindromes(const std::string& s) {
+    PalindromicTree tree;
+    for (char c : s) {
+        tree.add(c);
+    }
+    return tree.distinctPalindromes();
 }
 
 int main() {
-    std::cout << \"=== Longest Palindromic Subsequence ===\" << std::endl;
-    std::cout << \"Time: O(n²), Space: O(n²)\" << std::endl << std::endl;
+    std::cout << "=== Longest Palindromic Subsequence ===" << std::endl;
+    std::cout << "Time: O(n²), Space: O(n²)" << std::endl << std::endl;
+    
+    std::string s = "BBABCBCAB";
+    std::cout << "String: " << s << std::endl;
+    std::cout << "LPS Length: " << longestPalindromicSubsequence(s) << std::endl;
+    std::cout << "LPS Length (bit-parallel): " << longestPalindromicSubsequenceBitParallel(s) << std::endl;
+    std::cout << "Longest Palindromic Substring: " << longestPalindromicSubstring(s) << std::endl;
+    
+    // Manacher radii
+    std::string t = "abacabacaba";
+    PalindromeRadii radii = manacher(t);
+    std::cout << "\n=== Manacher's Algorithm (O(n)) ===" << std::endl;
+    std::cout << "String: " << t << std::endl;
+    std::cout << "Odd radii:  ";
+    for (int r : radii.odd) std::cout << r << " ";
+    std::cout << std::endl;
+    std::cout << "Even radii: ";
+    for (int r : radii.even) std::cout << r << " ";
+    std::cout << std::endl;
+    std::cout << "Longest palindromic substring: " << longestPalindromicSubstring(t) << std::endl;
+    std::cout << "Palindromic substrings: " << countPalindromicSubstrings(t) << std::endl;
     
-    std::string s = \"BBABCBCAB\";
-    std::cout << \"String: \" << s << std::endl;
-    std::cout << \"LPS Length: \" << longestPalindromicSubsequence(s) << std::endl;
-    std::cout << \"Longest Palindromic Substring: \" << longestPalindromicSubstring(s) << std::endl;
+    // Eertree
+    PalindromicTree tree;
+    for (char c : t) tree.add(c);
+    std::cout << "\n=== Palindromic Tree (Eertree) ===" << std::endl;
+    std::cout << "Distinct palindromes: " << tree.distinctPalindromes() << std::endl;
+    for (const auto& [palindrome, count] : tree.palindromeCounts()) {
+        std::cout << "  " << palindrome << " x" << count << std::endl;
+    }
+    
+    // A 10^6 character read: the O(n²) table would need ~10^12 cells
+    std::string read;
+    const char bases[] = "ACGT";
+    uint32_t state = 12345;
+    for (int i = 0; i < 1000000; i++) {
+        state = state * 1103515245 + 12345;
+        read.push_back(bases[(state >> 16) % 4]);
+    }
+    std::cout << "\n=== 10^6-base read ===" << std::endl;
+    std::cout << "Longest palindromic substring length: "
+              << longestPalindromicSubstring(read).length() << std::endl;
+    std::cout << "Distinct palindromes: " << countDistinctPalindromes(read) << std::endl;
     
     return 0;
 }
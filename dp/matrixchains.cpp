@@ -1,5 +1,7 @@
 #include <iostream>
 #include <vector>
+#include <string>
+#include <map>
 #include <climits>
 #include <algorithm>
 
@@ -8,38 +10,256 @@
 // Time Complexity: O(n³)
 // Space Complexity: O(n²)
 
-int matrixChainMultiplication(const std::vector<int>& dims) {
-    int n = dims.size() - 1;  // Number of matrices
+// Interval DP Framework
+// Many problems choose how to bracket a sequence of n leaves:
+//   cost[i][i] = leafCost(i)
+//   cost[i][j] = min over i <= k < j of cost[i][k] + cost[k+1][j] + joinCost(i, k, j)
+// Matrix chains, optimal BSTs, optimal merge patterns and alphabetic trees all
+// fit this shape. Costs are 64-bit; split[i][j] records the best k so the
+// bracketing can be rebuilt.
+struct IntervalPlan {
+    long long cost;
+    std::vector<std::vector<int>> split;  // split[i][j] = k: [i..k] then [k+1..j]
+};
+
+// General solver
+// Time: O(n³), Space: O(n²)
+template <typename LeafCost, typename JoinCost>
+IntervalPlan solveIntervalDP(int n, LeafCost leafCost, JoinCost joinCost) {
+    std::vector<std::vector<long long>> dp(n, std::vector<long long>(n, 0));
+    std::vector<std::vector<int>> split(n, std::vector<int>(n, -1));
     
-    // dp[i][j] = min operations to multiply matrices i to j
-    std::vector<std::vector<int>> dp(n, std::vector<int>(n, 0));
+    for (int i = 0; i < n; i++) {
+        dp[i][i] = leafCost(i);
+    }
     
-    // len = chain length
+    // len = interval length
     for (int len = 2; len <= n; len++) {
-        for (int i = 0; i < n - len + 1; i++) {
+        for (int i = 0; i + len - 1 < n; i++) {
             int j = i + len - 1;
-            dp[i][j] = INT_MAX;
+            dp[i][j] = LLONG_MAX;
             
             // Try all split points
             for (int k = i; k < j; k++) {
-                int cost = dp[i][k] + dp[k+1][j] + 
-                          dims[i] * dims[k+1] * dims[j+1];
-                dp[i][j] = std::min(dp[i][j], cost);
+                long long cost = dp[i][k] + dp[k+1][j] + joinCost(i, k, j);
+                if (cost < dp[i][j]) {
+                    dp[i][j] = cost;
+                    split[i][j] = k;
+                }
+            }
+        }
+    }
+    
+    return {n > 0 ? dp[0][n-1] : 0, split};
+}
+
+// Knuth's optimization
+// Time: O(n²), Space: O(n²)
+// Valid when the join cost depends only on the interval, w(i, j), and w obeys
+// the quadrangle inequality w(a,c) + w(b,d) <= w(a,d) + w(b,c) for a<=b<=c<=d
+// and is monotone under inclusion. Then the best split is monotone,
+// split[i][j-1] <= split[i][j] <= split[i+1][j], and scanning only that window
+// makes the work per diagonal O(n) in total.
+// Holds for optimal BSTs and merge patterns; NOT for matrix chains, whose
+// join cost depends on k.
+template <typename LeafCost, typename MergeCost>
+IntervalPlan solveIntervalDPKnuth(int n, LeafCost leafCost, MergeCost mergeCost) {
+    std::vector<std::vector<long long>> dp(n, std::vector<long long>(n, 0));
+    std::vector<std::vector<int>> split(n, std::vector<int>(n, -1));
+    
+    for (int i = 0; i < n; i++) {
+        dp[i][i] = leafCost(i);
+    }
+    
+    for (int len = 2; len <= n; len++) {
+        for (int i = 0; i + len - 1 < n; i++) {
+            int j = i + len - 1;
+            // Single leaves have no split; fall back to the interval ends
+            int lo = len == 2 ? i : split[i][j-1];
+            int hi = len == 2 ? i : std::min(split[i+1][j], j - 1);
+            long long w = mergeCost(i, j);
+            
+            dp[i][j] = LLONG_MAX;
+            for (int k = lo; k <= hi; k++) {
+                long long cost = dp[i][k] + dp[k+1][j] + w;
+                if (cost < dp[i][j]) {
+                    dp[i][j] = cost;
+                    split[i][j] = k;
+                }
             }
         }
     }
     
-    return dp[0][n-1];
+    return {n > 0 ? dp[0][n-1] : 0, split};
+}
+
+// Rebuild the bracketing of leaves [i..j], e.g. ((A1A2)A3)
+std::string parenthesize(const IntervalPlan& plan, int i, int j,
+                         const std::string& prefix = "A") {
+    if (i == j) {
+        return prefix + std::to_string(i + 1);
+    }
+    int k = plan.split[i][j];
+    return "(" + parenthesize(plan, i, k, prefix) + parenthesize(plan, k + 1, j, prefix) + ")";
+}
+
+// Matrix chain on the framework
+// Matrix i is dims[i] x dims[i+1]; joining [i..k] with [k+1..j] costs
+// dims[i] * dims[k+1] * dims[j+1]
+IntervalPlan matrixChainPlan(const std::vector<int>& dims) {
+    int n = std::max(0, (int)dims.size() - 1);  // Number of matrices
+    return solveIntervalDP(
+        n,
+        [](int) { return 0LL; },
+        [&dims](int i, int k, int j) {
+            return (long long)dims[i] * dims[k+1] * dims[j+1];
+        });
+}
+
+long long matrixChainMultiplication(const std::vector<int>& dims) {
+    return matrixChainPlan(dims).cost;
+}
+
+std::string matrixChainOrder(const std::vector<int>& dims) {
+    int n = (int)dims.size() - 1;
+    if (n <= 0) return "";
+    return parenthesize(matrixChainPlan(dims), 0, n - 1);
+}
+
+// Hu-Shing heuristic mode
+// Time: O(n), Space: O(n)
+// A chain of n matrices is a convex polygon on the n+1 dimensions, and every
+// bracketing is a triangulation whose triangle (a, b, c) costs
+// dims[a] * dims[b] * dims[c]. One stack sweep starting at the lightest vertex
+// V1 cuts off a vertex Vt between neighbours Vp and Vc whenever the local
+// exchange test prefers triangle (p, t, c) to fanning Vt from V1:
+//   1/w1 + 1/wt < 1/wp + 1/wc
+// Whatever survives is fanned from V1. Hu and Shing show this heuristic stays
+// within 15.47% of the optimum; use matrixChainPlan when the exact answer
+// matters. The exact O(n log n) Hu-Shing algorithm is not implemented here.
+struct ChainTriangulation {
+    long long cost;
+    std::string order;
+};
+
+ChainTriangulation matrixChainHuShingHeuristic(const std::vector<int>& dims) {
+    int vertices = dims.size();
+    int n = vertices - 1;
+    if (n <= 1) {
+        return {0, n == 1 ? "A1" : ""};
+    }
+    
+    int lightest = std::min_element(dims.begin(), dims.end()) - dims.begin();
+    auto w = [&dims](int v) { return (__int128)dims[v]; };
+    
+    // Triangles keyed by their outer edge (a, c), a < c, mapping to apex b
+    std::map<std::pair<int, int>, int> apex;
+    long long cost = 0;
+    auto addTriangle = [&](int a, int b, int c) {
+        int lo = std::min({a, b, c}), hi = std::max({a, b, c});
+        int mid = a + b + c - lo - hi;
+        apex[{lo, hi}] = mid;
+        cost += (long long)dims[a] * dims[b] * dims[c];
+    };
+    
+    std::vector<int> stack = {lightest};
+    for (int step = 1; step < vertices; step++) {
+        int c = (lightest + step) % vertices;
+        while (stack.size() >= 2) {
+            int t = stack.back();
+            int p = stack[stack.size() - 2];
+            // 1/w1 + 1/wt < 1/wp + 1/wc, multiplied through by w1*wt*wp*wc
+            __int128 lhs = w(p) * w(c) * (w(t) + w(lightest));
+            __int128 rhs = w(lightest) * w(t) * (w(p) + w(c));
+            if (lhs >= rhs) break;
+            addTriangle(p, t, c);
+            stack.pop_back();
+        }
+        stack.push_back(c);
+    }
+    for (size_t i = 1; i + 1 < stack.size(); i++) {
+        addTriangle(lightest, stack[i], stack[i + 1]);
+    }
+    
+    // The triangle on edge (0, n) is the last multiplication; recurse inward
+    auto build = [&](auto& self, int a, int c) -> std::string {
+        if (c - a == 1) {
+            return "A" + std::to_string(c);
+        }
+        int b = apex[{a, c}];
+        return "(" + self(self, a, b) + self(self, b, c) + ")";
+    };
+    
+    return {cost, build(build, 0, n)};
+}
+
+// Optimal BST on the framework
+// Keys 1..n with search frequencies p[1..n] and miss frequencies q[0..n].
+// The misses d0..dn are the leaves, in order, and every key is the internal
+// node joining the leaves on either side of it, so splitting leaves [i..j]
+// after leaf k puts key k+1 at the root. Joining adds one level to everything
+// in the interval, i.e. w(i, j) = q[i..j] + p[i+1..j], which satisfies the
+// quadrangle inequality, so Knuth's O(n²) solver applies.
+IntervalPlan optimalBSTPlan(const std::vector<int>& p, const std::vector<int>& q, bool knuth) {
+    int leaves = q.size();
+    std::vector<long long> prefixQ(leaves + 1, 0), prefixP(leaves + 1, 0);
+    for (int i = 0; i < leaves; i++) {
+        prefixQ[i + 1] = prefixQ[i] + q[i];
+        prefixP[i + 1] = prefixP[i] + (i > 0 ? p[i] : 0);  // p[0] is unused
+    }
+    
+    auto leafCost = [&q](int i) { return (long long)q[i]; };
+    auto weight = [&](int i, int j) {
+        return prefixQ[j + 1] - prefixQ[i] + prefixP[j + 1] - prefixP[i + 1];
+    };
+    
+    if (knuth) {
+        return solveIntervalDPKnuth(leaves, leafCost, weight);
+    }
+    return solveIntervalDP(leaves, leafCost, [&weight](int i, int, int j) { return weight(i, j); });
 }
 
 int main() {
-    std::cout << \"=== Matrix Chain Multiplication ===\" << std::endl;
-    std::cout << \"Time: O(n³), Space: O(n²)\" << std::endl << std::endl;
+    std::cout << "=== Matrix Chain Multiplication ===" << std::endl;
+    std::cout << "Time: O(n³), Space: O(n²)" << std::endl << std::endl;
     
     // Matrix dimensions: A1(10x30), A2(30x5), A3(5x60)
     std::vector<int> dims = {10, 30, 5, 60};
-    std::cout << \"Matrices: A1(10x30), A2(30x5), A3(5x60)\" << std::endl;
-    std::cout << \"Min multiplications: \" << matrixChainMultiplication(dims) << std::endl;
+    std::cout << "Matrices: A1(10x30), A2(30x5), A3(5x60)" << std::endl;
+    std::cout << "Min multiplications: " << matrixChainMultiplication(dims) << std::endl;
+    std::cout << "Optimal order: " << matrixChainOrder(dims) << std::endl;
+    
+    // Costs past INT_MAX are fine with 64-bit accumulation
+    std::vector<int> wide = {4000, 200, 3000, 100, 5000, 50, 4000};
+    std::cout << "\nDimensions: ";
+    for (int d : wide) std::cout << d << " ";
+    std::cout << std::endl;
+    std::cout << "Min multiplications: " << matrixChainMultiplication(wide) << std::endl;
+    std::cout << "Optimal order: " << matrixChainOrder(wide) << std::endl;
+    
+    ChainTriangulation fast = matrixChainHuShingHeuristic(wide);
+    std::cout << "Hu-Shing O(n) heuristic: " << fast.cost << " " << fast.order << std::endl;
+    
+    // Long chain: exact vs linear-time heuristic
+    std::vector<int> chain;
+    for (int i = 0; i <= 300; i++) {
+        chain.push_back(10 + (i * 37 + i * i * 11) % 490);
+    }
+    long long exact = matrixChainMultiplication(chain);
+    long long heuristic = matrixChainHuShingHeuristic(chain).cost;
+    std::cout << "\nChain of 300 matrices:" << std::endl;
+    std::cout << "  Exact O(n³): " << exact << std::endl;
+    std::cout << "  Hu-Shing O(n): " << heuristic << " (+"
+              << 100.0 * (heuristic - exact) / exact << "%)" << std::endl;
+    
+    // Optimal BST: CLRS example, frequencies scaled to integers
+    std::cout << "\n=== Optimal Binary Search Tree ===" << std::endl;
+    std::vector<int> p = {0, 15, 10, 5, 10, 20};
+    std::vector<int> q = {5, 10, 5, 5, 5, 10};
+    IntervalPlan bst = optimalBSTPlan(p, q, true);
+    std::cout << "Expected cost x100 (Knuth O(n²)): " << bst.cost << std::endl;
+    std::cout << "Expected cost x100 (O(n³)): " << optimalBSTPlan(p, q, false).cost << std::endl;
+    std::cout << "Root key: k" << bst.split[0][q.size() - 1] + 1 << std::endl;
     
     return 0;
 }
@@ -0,0 +1,187 @@
+#ifndef MEMO_H
+#define MEMO_H
+
+#include <vector>
+#include <array>
+#include <cstdint>
+#include <cstddef>
+
+// Memoization Cache for top-down DPs
+// Keys are D-dimensional integer states inside a known shape, e.g. {index,
+// capacity} for knapsack or {i, j} for LCS. The backend follows the shape:
+//   - Dense: one flat array over the whole shape, used when it fits the
+//     memory budget. O(1) lookups and no hashing.
+//   - Hash: open addressing with linear probing, used when the full shape is
+//     too big. Holds at most as many entries as the budget allows; once full,
+//     a CLOCK sweep (an LRU approximation with one reference bit per slot)
+//     evicts a state that was not used since the hand last passed it.
+// An evicted state is simply recomputed, so a bounded cache trades time for
+// memory without changing results. stats() reports hits, misses and
+// evictions for tuning the budget.
+
+struct MemoStats {
+    long long hits = 0;
+    long long misses = 0;
+    long long evictions = 0;
+    
+    double hitRate() const {
+        long long lookups = hits + misses;
+        return lookups == 0 ? 0.0 : (double)hits / lookups;
+    }
+};
+
+template <int D, typename Value>
+class MemoCache {
+public:
+    using Key = std::array<int, D>;
+    
+    // budgetBytes == 0 means unbounded
+    explicit MemoCache(const Key& keyShape, size_t budgetBytes = 0) : shape(keyShape) {
+        size_t cells = 1;
+        for (int d = 0; d < D; d++) {
+            cells *= shape[d];
+        }
+        
+        size_t denseBytes = cells * (sizeof(Value) + 1);
+        if (budgetBytes == 0 || denseBytes <= budgetBytes) {
+            isDense = true;
+            denseValues.resize(cells);
+            denseKnown.assign(cells, 0);
+            return;
+        }
+        
+        // Largest power-of-two table that fits the budget (two slots at
+        // least), kept at most half full for short probe sequences
+        isDense = false;
+        size_t tableSize = 2;
+        while (2 * tableSize * sizeof(Slot) <= budgetBytes) {
+            tableSize <<= 1;
+        }
+        maxEntries = tableSize / 2;
+        slots.resize(tableSize);
+        mask = tableSize - 1;
+    }
+    
+    // Pointer to the cached value, or nullptr. Copy the value out before the
+    // next store(): a store may move or evict it.
+    const Value* find(const Key& key) {
+        if (isDense) {
+            size_t index = flatten(key);
+            if (denseKnown[index]) {
+                counters.hits++;
+                return &denseValues[index];
+            }
+            counters.misses++;
+            return nullptr;
+        }
+        
+        uint64_t code = flatten(key);
+        for (size_t i = hashOf(code) & mask; slots[i].used; i = (i + 1) & mask) {
+            if (slots[i].code == code) {
+                slots[i].referenced = true;
+                counters.hits++;
+                return &slots[i].value;
+            }
+        }
+        counters.misses++;
+        return nullptr;
+    }
+    
+    void store(const Key& key, const Value& value) {
+        if (isDense) {
+            size_t index = flatten(key);
+            denseValues[index] = value;
+            denseKnown[index] = 1;
+            return;
+        }
+        
+        uint64_t code = flatten(key);
+        size_t i = hashOf(code) & mask;
+        for (; slots[i].used; i = (i + 1) & mask) {
+            if (slots[i].code == code) {
+                slots[i].value = value;
+                slots[i].referenced = true;
+                return;
+            }
+        }
+        
+        if (entries == maxEntries) {
+            evict();
+            // Eviction shifts slots around; find the free slot again
+            for (i = hashOf(code) & mask; slots[i].used; i = (i + 1) & mask) {}
+        }
+        slots[i] = {code, value, true, true};
+        entries++;
+    }
+    
+    bool dense() const { return isDense; }
+    size_t size() const { return isDense ? denseValues.size() : entries; }
+    const MemoStats& stats() const { return counters; }
+
+private:
+    struct Slot {
+        uint64_t code = 0;
+        Value value{};
+        bool used = false;
+        bool referenced = false;  // CLOCK reference bit
+    };
+    
+    Key shape;
+    bool isDense = true;
+    MemoStats counters;
+    
+    // Dense backend
+    std::vector<Value> denseValues;
+    std::vector<uint8_t> denseKnown;
+    
+    // Hash backend
+    std::vector<Slot> slots;
+    size_t mask = 0;
+    size_t entries = 0;
+    size_t maxEntries = 0;
+    size_t hand = 0;  // CLOCK hand
+    
+    size_t flatten(const Key& key) const {
+        size_t index = 0;
+        for (int d = 0; d < D; d++) {
+            index = index * shape[d] + key[d];
+        }
+        return index;
+    }
+    
+    // splitmix64 finalizer: consecutive states land in unrelated slots
+    static uint64_t hashOf(uint64_t x) {
+        x += 0x9e3779b97f4a7c15ULL;
+        x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+        return x ^ (x >> 31);
+    }
+    
+    // Sweep the hand, clearing reference bits, until an unreferenced entry
+    // turns up; remove it with backward-shift deletion so probe chains stay
+    // intact without tombstones
+    void evict() {
+        while (true) {
+            Slot& slot = slots[hand];
+            if (slot.used && !slot.referenced) break;
+            slot.referenced = false;
+            hand = (hand + 1) & mask;
+        }
+        
+        size_t hole = hand;
+        slots[hole].used = false;
+        for (size_t i = (hole + 1) & mask; slots[i].used; i = (i + 1) & mask) {
+            size_t home = hashOf(slots[i].code) & mask;
+            // Move slot i into the hole if its home is not in (hole, i]
+            if (((i - home) & mask) >= ((i - hole) & mask)) {
+                slots[hole] = slots[i];
+                slots[i].used = false;
+                hole = i;
+            }
+        }
+        entries--;
+        counters.evictions++;
+    }
+};
+
+#endif
@@ -1,5 +1,12 @@
 #include <iostream>
 #include <vector>
+#include <thread>
+#include <algorithm>
+#include <cstdint>
+#include <stdexcept>
+#include <climits>
+#include "counting.h"
+#include "subsetsum.h"
 
 // Subset Sum Problem
 // Determine if there's a subset with given sum
@@ -7,51 +14,248 @@
 // Space Complexity: O(sum)
 
 bool subsetSum(const std::vector<int>& arr, int targetSum) {
-    int n = arr.size();
+    if (targetSum < 0) return false;
+    SubsetSumBitset engine(targetSum);
+    engine.addAll(arr);
+    return engine.reachable(targetSum);
+}
+
+// Multithreaded mode for very large targets
+// Time: O(n * sum / (64 * threads)) plus one barrier per shift; the threads
+// start once per call
+bool subsetSumParallel(const std::vector<int>& arr, int targetSum, int threads = 0) {
+    if (targetSum < 0) return false;
+    if (threads <= 0) {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    SubsetSumBitset engine(targetSum);
+    engine.addAll(arr, threads);
+    return engine.reachable(targetSum);
+}
+
+// Partition into two equal-sum halves reduces to subset sum with target sum/2
+bool canPartition(const std::vector<int>& arr) {
+    long long sum = 0;
+    for (int x : arr) {
+        if (x < 0) throw std::runtime_error("canPartition: negative element");
+        sum += x;
+    }
     
-    // dp[i] = true if sum i is possible
-    std::vector<bool> dp(targetSum + 1, false);
-    dp[0] = true;  // Sum 0 always possible (empty subset)
+    if (sum % 2 != 0) return false;
+    if (sum / 2 > INT_MAX) throw std::runtime_error("canPartition: half sum exceeds int range");
+    return subsetSum(arr, sum / 2);
+}
+
+// Count number of subsets with given sum
+// Count selects the arithmetic: ModInt<P>, Count128 or BigCount (see counting.h)
+// Each item reads the previous row and writes the next, so the shift-add over
+// the sum dimension runs in vector lanes instead of a dependent in-place loop.
+template <typename Count = Mod1e9_7>
+Count countSubsetSum(const std::vector<int>& arr, int targetSum) {
+    if (targetSum < 0) return Count(0);
+    std::vector<Count> dp(targetSum + 1, Count(0));
+    std::vector<Count> next(targetSum + 1, Count(0));
+    dp[0] = Count(1);
     
     for (int num : arr) {
-        // Traverse right to left to avoid using same element twice
-        for (int sum = targetSum; sum >= num; sum--) {
-            if (dp[sum - num]) {
-                dp[sum] = true;
+        if (num < 0 || num > targetSum) continue;
+        addShiftedLanes(dp.data(), next.data(), num, targetSum + 1);
+        dp.swap(next);
+    }
+    
+    return dp[targetSum];
+}
+
+// FFT-based counting
+// Time: O(min(W log n, n * sum) log sum) for total weight W, Space: O(sum)
+// The number of subsets with sum s is the coefficient of x^s in the product
+// (1 + x^a1)(1 + x^a2)...(1 + x^an). The factors are multiplied pairwise in a
+// balanced tree with a number-theoretic transform (an FFT over integers mod a
+// prime), so counts are exact modulo NTT_MOD instead of rounded doubles.
+// Every product is cut at degree sum, so a tree level costs at most
+// min(W, groups * sum) coefficients.
+const uint32_t NTT_MOD = 998244353;  // 119 * 2^23 + 1
+const uint32_t NTT_ROOT = 3;
+const int NTT_MAX_LENGTH = 1 << 23;  // Longest transform NTT_MOD has a root of unity for
+
+uint32_t powMod(uint64_t base, uint64_t exp) {
+    uint64_t result = 1;
+    base %= NTT_MOD;
+    while (exp > 0) {
+        if (exp & 1) result = result * base % NTT_MOD;
+        base = base * base % NTT_MOD;
+        exp >>= 1;
+    }
+    return result;
+}
+
+// Iterative transform using bit-reversal
+void ntt(std::vector<uint32_t>& a, bool inverse) {
+    int n = a.size();
+    
+    for (int i = 1, j = 0; i < n; i++) {
+        int bit = n >> 1;
+        for (; j & bit; bit >>= 1) {
+            j ^= bit;
+        }
+        j ^= bit;
+        if (i < j) {
+            std::swap(a[i], a[j]);
+        }
+    }
+    
+    for (int len = 2; len <= n; len <<= 1) {
+        uint64_t wn = powMod(NTT_ROOT, (NTT_MOD - 1) / len);
+        if (inverse) wn = powMod(wn, NTT_MOD - 2);
+        
+        for (int i = 0; i < n; i += len) {
+            uint64_t w = 1;
+            for (int j = 0; j < len / 2; j++) {
+                uint32_t u = a[i + j];
+                uint32_t v = a[i + j + len / 2] * w % NTT_MOD;
+                a[i + j] = u + v < NTT_MOD ? u + v : u + v - NTT_MOD;
+                a[i + j + len / 2] = u >= v ? u - v : u + NTT_MOD - v;
+                w = w * wn % NTT_MOD;
             }
         }
     }
     
-    return dp[targetSum];
+    if (inverse) {
+        uint64_t nInv = powMod(n, NTT_MOD - 2);
+        for (uint32_t& x : a) {
+            x = x * nInv % NTT_MOD;
+        }
+    }
 }
 
-// Count number of subsets with given sum
-int countSubsetSum(const std::vector<int>& arr, int targetSum) {
-    std::vector<int> dp(targetSum + 1, 0);
-    dp[0] = 1;
+// Product of two polynomials, truncated to degree limit
+// Products longer than NTT_MAX_LENGTH (targets past about 2^22) split the
+// longer factor in two and add the partial products, so every transform
+// stays within the lengths NTT_MOD supports.
+std::vector<uint32_t> multiplyTruncated(std::vector<uint32_t> a, std::vector<uint32_t> b, int limit) {
+    if ((int)a.size() > limit + 1) a.resize(limit + 1);
+    if ((int)b.size() > limit + 1) b.resize(limit + 1);
+    int resultSize = std::min<int>(a.size() + b.size() - 1, limit + 1);
     
-    for (int num : arr) {
-        for (int sum = targetSum; sum >= num; sum--) {
-            dp[sum] += dp[sum - num];
+    if ((long long)a.size() + b.size() - 1 > NTT_MAX_LENGTH) {
+        if (a.size() < b.size()) a.swap(b);
+        int half = a.size() / 2;
+        std::vector<uint32_t> high(a.begin() + half, a.end());
+        a.resize(half);
+        
+        std::vector<uint32_t> result = multiplyTruncated(std::move(a), b, limit);
+        result.resize(resultSize, 0);
+        if (half <= limit) {
+            // x^half * high * b, of which only degrees up to limit matter
+            std::vector<uint32_t> upper = multiplyTruncated(std::move(high), std::move(b), limit - half);
+            for (size_t i = 0; i < upper.size(); i++) {
+                uint32_t sum = result[half + i] + upper[i];
+                result[half + i] = sum < NTT_MOD ? sum : sum - NTT_MOD;
+            }
         }
+        return result;
     }
     
-    return dp[targetSum];
+    int n = 1;
+    while (n < (int)(a.size() + b.size() - 1)) {
+        n <<= 1;
+    }
+    a.resize(n);
+    b.resize(n);
+    
+    ntt(a, false);
+    ntt(b, false);
+    for (int i = 0; i < n; i++) {
+        a[i] = (uint64_t)a[i] * b[i] % NTT_MOD;
+    }
+    ntt(a, true);
+    
+    a.resize(resultSize);
+    return a;
+}
+
+// Weights are non-negative here; countSubsetSumFFT checks before recursing
+std::vector<uint32_t> subsetProduct(const std::vector<int>& arr, int lo, int hi, int limit) {
+    if (hi - lo == 1) {
+        std::vector<uint32_t> factor(std::min(arr[lo], limit) + 1, 0);
+        factor[0] = 1;
+        if (arr[lo] <= limit) factor[arr[lo]] += 1;  // Also handles a zero weight
+        return factor;
+    }
+    int mid = lo + (hi - lo) / 2;
+    return multiplyTruncated(subsetProduct(arr, lo, mid, limit),
+                             subsetProduct(arr, mid, hi, limit), limit);
+}
+
+uint32_t countSubsetSumFFT(const std::vector<int>& arr, int targetSum) {
+    for (int x : arr) {
+        if (x < 0) throw std::runtime_error("countSubsetSumFFT: negative element");
+    }
+    if (targetSum < 0) return 0;
+    if (arr.empty()) return targetSum == 0 ? 1 : 0;
+    
+    std::vector<uint32_t> poly = subsetProduct(arr, 0, arr.size(), targetSum);
+    return targetSum < (int)poly.size() ? poly[targetSum] : 0;
 }
 
 int main() {
-    std::cout << \"=== Subset Sum Problem ===\" << std::endl;
-    std::cout << \"Time: O(n*sum), Space: O(sum)\" << std::endl << std::endl;
+    std::cout << "=== Subset Sum Problem ===" << std::endl;
+    std::cout << "Time: O(n*sum/64), Space: O(sum/64) words" << std::endl << std::endl;
     
     std::vector<int> arr = {3, 34, 4, 12, 5, 2};
     int target = 9;
     
-    std::cout << \"Array: \";
-    for (int x : arr) std::cout << x << \" \";
+    std::cout << "Array: ";
+    for (int x : arr) std::cout << x << " ";
+    std::cout << std::endl;
+    std::cout << "Target sum: " << target << std::endl;
+    std::cout << "Exists: " << (subsetSum(arr, target) ? "Yes" : "No") << std::endl;
+    std::cout << "Count: " << countSubsetSum<long long>(arr, target) << std::endl;
+    std::cout << "Count (FFT): " << countSubsetSumFFT(arr, target) << std::endl;
+    
+    // Partition
+    std::vector<int> partitionArr = {1, 5, 11, 5};
+    std::cout << "\n=== Partition ===" << std::endl;
+    std::cout << "Array: ";
+    for (int x : partitionArr) std::cout << x << " ";
     std::cout << std::endl;
-    std::cout << \"Target sum: \" << target << std::endl;
-    std::cout << \"Exists: \" << (subsetSum(arr, target) ? \"Yes\" : \"No\") << std::endl;
-    std::cout << \"Count: \" << countSubsetSum(arr, target) << std::endl;
+    std::cout << "Can partition: " << (canPartition(partitionArr) ? "Yes" : "No") << std::endl;
+    
+    // Many repeated weights: binary splitting keeps the shift count small
+    std::vector<int> repeated;
+    for (int i = 0; i < 5000; i++) {
+        repeated.push_back(7);
+        repeated.push_back(1000);
+    }
+    int largeTarget = 3000000;
+    std::cout << "\n=== Repeated Weights (10000 items) ===" << std::endl;
+    std::cout << "Target sum: " << largeTarget << std::endl;
+    std::cout << "Exists: " << (subsetSum(repeated, largeTarget) ? "Yes" : "No") << std::endl;
+    std::cout << "Exists (parallel): " << (subsetSumParallel(repeated, largeTarget, 4) ? "Yes" : "No") << std::endl;
+    std::cout << "Sum 6: " << (subsetSum(repeated, 6) ? "Yes" : "No") << std::endl;
+    
+    // FFT counting on a larger instance
+    std::vector<int> small;
+    for (int i = 1; i <= 60; i++) small.push_back(i);
+    std::cout << "\n=== Counting subsets of {1..60} with sum 200 ===" << std::endl;
+    std::cout << "DP (mod 1e9+7): " << countSubsetSum(small, 200) << std::endl;
+    std::cout << "DP (mod " << NTT_MOD << "): " << countSubsetSum<ModInt<NTT_MOD>>(small, 200) << std::endl;
+    std::cout << "FFT (mod " << NTT_MOD << "): " << countSubsetSumFFT(small, 200) << std::endl;
+    std::cout << "DP (128-bit): " << countSubsetSum<Count128>(small, 200) << std::endl;
+    
+    // Targets past 2^22 need products longer than one 2^23-point transform
+    std::vector<int> heavy = {1500000, 2500000, 1000000, 3000000};
+    std::cout << "\n=== Counting subsets of {1.5M, 2.5M, 1M, 3M} with sum 4M ===" << std::endl;
+    std::cout << "DP (mod 1e9+7): " << countSubsetSum(heavy, 4000000) << std::endl;
+    std::cout << "FFT (mod " << NTT_MOD << "): " << countSubsetSumFFT(heavy, 4000000) << std::endl;
+    
+    // C(100, 50) is past 2^64: long long wraps, the exact types do not
+    std::vector<int> ones(100, 1);
+    std::cout << "\n=== Counting subsets of 100 ones with sum 50 ===" << std::endl;
+    std::cout << "DP (64-bit): " << countSubsetSum<unsigned long long>(ones, 50) << " (wrapped)" << std::endl;
+    std::cout << "DP (128-bit): " << countSubsetSum<Count128>(ones, 50) << std::endl;
+    std::cout << "DP (BigCount): " << countSubsetSum<BigCount>(ones, 50) << std::endl;
+    std::cout << "C(100, 50): " << binomialCount<BigCount>(100, 50) << std::endl;
     
     return 0;
 }
@@ -0,0 +1,171 @@
+#ifndef SUBSETSUM_H
+#define SUBSETSUM_H
+
+#include <vector>
+#include <map>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <algorithm>
+#include <cstdint>
+
+// Bitset Subset Sum Engine
+// Time Complexity: O(n * sum / 64), Space: O(sum / 64) words
+// Bit s of the bitset is set when sum s is reachable. Adding an item a is the
+// single word-parallel update reach |= reach << a, which handles 64 sums per
+// instruction instead of one.
+class SubsetSumBitset {
+private:
+    static const int WORD = 64;
+    int target;
+    std::vector<uint64_t> reach;
+    
+    // Reusable barrier: the last thread to arrive releases the others
+    class Barrier {
+    private:
+        std::mutex lock;
+        std::condition_variable released;
+        int parties;
+        int waiting = 0;
+        long long generation = 0;
+    
+    public:
+        explicit Barrier(int count) : parties(count) {}
+        
+        void wait() {
+            std::unique_lock<std::mutex> guard(lock);
+            long long arrived = generation;
+            if (++waiting == parties) {
+                waiting = 0;
+                generation++;
+                released.notify_all();
+            } else {
+                released.wait(guard, [&] { return generation != arrived; });
+            }
+        }
+    };
+    
+    // Clear the bits past target so they never leak into later shifts
+    void trim(uint64_t& last) const {
+        int extra = reach.size() * WORD - (target + 1);
+        if (extra > 0) {
+            last &= ~uint64_t(0) >> extra;
+        }
+    }
+    
+    // dst[i] = src[i] | (src << shift)[i] for words in [from, to)
+    static void shiftOrRange(const uint64_t* src, uint64_t* dst, int shift, int from, int to) {
+        int wordShift = shift / WORD;
+        int bitShift = shift % WORD;
+        for (int i = from; i < to; i++) {
+            uint64_t shifted = 0;
+            if (i - wordShift >= 0) {
+                shifted = src[i - wordShift] << bitShift;
+                if (bitShift != 0 && i - wordShift - 1 >= 0) {
+                    shifted |= src[i - wordShift - 1] >> (WORD - bitShift);
+                }
+            }
+            dst[i] = src[i] | shifted;
+        }
+    }
+    
+    // All shifts with one set of threads, each owning a fixed word range.
+    // Shift k reads buffer k % 2 and writes the other, so a range never
+    // depends on output another thread is still writing; the barrier between
+    // shifts makes the whole new bitset visible before anyone reads it.
+    void addParallel(const std::vector<int>& shifts, int threads) {
+        int words = reach.size();
+        threads = std::min(threads, words);
+        std::vector<uint64_t> spare(words);
+        uint64_t* buffers[2] = {reach.data(), spare.data()};
+        int chunk = (words + threads - 1) / threads;
+        Barrier barrier(threads);
+        
+        auto worker = [&](int t) {
+            int from = std::min(words, t * chunk);
+            int to = std::min(words, from + chunk);
+            for (size_t k = 0; k < shifts.size(); k++) {
+                const uint64_t* src = buffers[k % 2];
+                uint64_t* dst = buffers[1 - k % 2];
+                shiftOrRange(src, dst, shifts[k], from, to);
+                if (from < to && to == words) trim(dst[words - 1]);
+                barrier.wait();
+            }
+        };
+        
+        std::vector<std::thread> pool;
+        for (int t = 1; t < threads; t++) {
+            pool.emplace_back(worker, t);
+        }
+        worker(0);
+        for (std::thread& thread : pool) {
+            thread.join();
+        }
+        
+        // An odd number of shifts leaves the result in the spare buffer
+        if (shifts.size() % 2 == 1) reach.swap(spare);
+    }
+
+public:
+    SubsetSumBitset(int targetSum)
+        : target(targetSum), reach(targetSum / WORD + 1, 0) {
+        reach[0] = 1;  // Sum 0 always possible (empty subset)
+    }
+    
+    // reach |= reach << shift, in place
+    void add(int shift) {
+        if (shift < 0 || shift > target) return;
+        int words = reach.size();
+        int wordShift = shift / WORD;
+        int bitShift = shift % WORD;
+        
+        // High to low, so every source word is read before it is overwritten
+        for (int i = words - 1; i >= wordShift; i--) {
+            uint64_t shifted = reach[i - wordShift] << bitShift;
+            if (bitShift != 0 && i - wordShift - 1 >= 0) {
+                shifted |= reach[i - wordShift - 1] >> (WORD - bitShift);
+            }
+            reach[i] |= shifted;
+        }
+        trim(reach.back());
+    }
+    
+    // Items of equal weight are grouped by binary splitting: c copies of a
+    // become shifts by a, 2a, 4a, ..., so a group costs O(log c) shifts.
+    // With threads > 1 the threads start once for the whole list.
+    void addAll(const std::vector<int>& arr, int threads = 1) {
+        std::map<int, int> counts;
+        for (int num : arr) {
+            counts[num]++;
+        }
+        
+        std::vector<int> shifts;
+        for (const auto& [weight, count] : counts) {
+            // Zeros never change reachability; sums here are non-negative
+            if (weight <= 0) continue;
+            int remaining = count;
+            for (int piece = 1; remaining > 0; piece *= 2) {
+                int take = std::min(piece, remaining);
+                remaining -= take;
+                // Stop once the shift runs past the target
+                if ((long long)weight * take > target) break;
+                shifts.push_back(weight * take);
+            }
+        }
+        
+        if (threads > 1 && !shifts.empty()) {
+            addParallel(shifts, threads);
+        } else {
+            for (int shift : shifts) {
+                add(shift);
+            }
+        }
+    }
+    
+    bool reachable(int sum) const {
+        if (sum < 0 || sum > target) return false;
+        return (reach[sum / WORD] >> (sum % WORD)) & 1;
+    }
+};
+
+#endif
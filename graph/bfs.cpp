@@ -1,41 +1,86 @@
 #include <iostream>
 #include <vector>
 #include <queue>
-#include <list>
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <climits>
+#include <cstdint>
+#include "csr.h"
 
 // Breadth-First Search (BFS)
 // Time Complexity: O(V + E)
 // Space Complexity: O(V)
+// Neighbours are scanned from a CSR graph (csr.h): one contiguous range per
+// vertex instead of a linked list.
+
+// Distances and a shortest-path tree from one source
+// distance[v] = -1 and parent[v] = -1 when v is unreachable; the source has
+// distance 0 and parent -1
+struct BFSTree {
+    std::vector<int> distance;
+    std::vector<int> parent;
+};
 
 class Graph {
 private:
     int V;  // Number of vertices
-    std::vector<std::list<int>> adj;  // Adjacency list
+    CSRBuilder adj;  // Edge list, frozen to CSR on the first query
+    CSRGraph reverse;  // In-edges for bottom-up steps, sources ascending
+    bool reverseStale = true;
+    
+    const CSRGraph& reverseGraph() {
+        if (reverseStale) {
+            reverse = adj.graph().transpose();
+            reverseStale = false;
+        }
+        return reverse;
+    }
     
+    template <typename Fn>
+    static void runThreads(int threads, Fn fn) {
+        std::vector<std::thread> pool;
+        for (int t = 1; t < threads; t++) {
+            pool.emplace_back(fn, t);
+        }
+        fn(0);
+        for (std::thread& worker : pool) {
+            worker.join();
+        }
+    }
+    
+    static void atomicMin(std::atomic<int>& target, int value) {
+        int current = target.load(std::memory_order_relaxed);
+        while (value < current &&
+               !target.compare_exchange_weak(current, value, std::memory_order_relaxed)) {}
+    }
+
 public:
     Graph(int vertices) : V(vertices), adj(vertices) {}
     
     void addEdge(int u, int v) {
-        adj[u].push_back(v);
+        adj.addEdge(u, v);
+        reverseStale = true;
     }
     
     // BFS from source vertex
     void BFS(int start) {
+        const CSRGraph& graph = adj.graph();
         std::vector<bool> visited(V, false);
         std::queue<int> queue;
         
         visited[start] = true;
         queue.push(start);
         
-        std::cout << \"BFS traversal starting from \" << start << \": \";
+        std::cout << "BFS traversal starting from " << start << ": ";
         
         while (!queue.empty()) {
             int vertex = queue.front();
             queue.pop();
-            std::cout << vertex << \" \";
+            std::cout << vertex << " ";
             
             // Visit all adjacent vertices
-            for (int neighbor : adj[vertex]) {
+            for (int neighbor : graph.neighbors(vertex)) {
                 if (!visited[neighbor]) {
                     visited[neighbor] = true;
                     queue.push(neighbor);
@@ -47,6 +92,7 @@ public:
     
     // BFS with distance calculation
     std::vector<int> BFSDistance(int start) {
+        const CSRGraph& graph = adj.graph();
         std::vector<int> distance(V, -1);
         std::queue<int> queue;
         
@@ -57,7 +103,7 @@ public:
             int vertex = queue.front();
             queue.pop();
             
-            for (int neighbor : adj[vertex]) {
+            for (int neighbor : graph.neighbors(vertex)) {
                 if (distance[neighbor] == -1) {
                     distance[neighbor] = distance[vertex] + 1;
                     queue.push(neighbor);
@@ -71,6 +117,7 @@ public:
     // Check if path exists between two vertices
     bool hasPath(int start, int end) {
         if (start == end) return true;
+        const CSRGraph& graph = adj.graph();
         
         std::vector<bool> visited(V, false);
         std::queue<int> queue;
@@ -82,7 +129,7 @@ public:
             int vertex = queue.front();
             queue.pop();
             
-            for (int neighbor : adj[vertex]) {
+            for (int neighbor : graph.neighbors(vertex)) {
                 if (neighbor == end) return true;
                 
                 if (!visited[neighbor]) {
@@ -97,6 +144,7 @@ public:
     
     // Find shortest path
     std::vector<int> shortestPath(int start, int end) {
+        const CSRGraph& graph = adj.graph();
         std::vector<int> parent(V, -1);
         std::vector<bool> visited(V, false);
         std::queue<int> queue;
@@ -110,7 +158,7 @@ public:
             
             if (vertex == end) break;
             
-            for (int neighbor : adj[vertex]) {
+            for (int neighbor : graph.neighbors(vertex)) {
                 if (!visited[neighbor]) {
                     visited[neighbor] = true;
                     parent[neighbor] = vertex;
@@ -130,11 +178,305 @@ public:
         
         return path;
     }
+    
+    // Direction-optimizing parallel BFS (Beamer, Asanovic, Patterson)
+    // Time: O(V + E) work, Space: O(V + E) for the cached in-edge CSR
+    // Top-down steps expand a frontier queue: threads take blocks of it,
+    // claim unvisited out-neighbours with a CAS on their distance and collect
+    // them in a local queue, and the local queues are joined for the next
+    // level. When the edges leaving the frontier exceed the edges into
+    // unvisited vertices divided by ALPHA, a bottom-up step is cheaper: every
+    // unvisited vertex scans its in-edges against a frontier bitmap and stops
+    // at the first hit. On low-diameter graphs a few middle levels hold most
+    // vertices, and bottom-up skips most of their edges. Once the frontier
+    // shrinks below V / BETA vertices, steps go top-down again.
+    // Distances equal BFSDistance. Where several vertices one level closer
+    // reach v, parent[v] is the lowest-numbered of them, so the tree does not
+    // depend on thread count or timing; the serial BFS keeps whichever it
+    // dequeued first. Both are shortest-path trees.
+    BFSTree BFSParallel(int start, int threads = 0) {
+        const int ALPHA = 14, BETA = 24;
+        const int TOP_DOWN_BLOCK = 256;    // Frontier vertices per grab
+        const int BOTTOM_UP_BLOCK = 64;    // Bitmap words per grab
+        if (threads <= 0) {
+            threads = std::max(1u, std::thread::hardware_concurrency());
+        }
+        
+        const CSRGraph& out = adj.graph();
+        const CSRGraph& in = reverseGraph();
+        int words = (V + 63) / 64;
+        
+        std::vector<std::atomic<int>> distance(V), parent(V);
+        std::vector<std::atomic<uint64_t>> visited(words), frontierBits(words), nextBits(words);
+        for (int v = 0; v < V; v++) {
+            distance[v].store(-1, std::memory_order_relaxed);
+            parent[v].store(INT_MAX, std::memory_order_relaxed);
+        }
+        
+        distance[start].store(0, std::memory_order_relaxed);
+        parent[start].store(-1, std::memory_order_relaxed);
+        visited[start / 64].store(uint64_t(1) << (start % 64), std::memory_order_relaxed);
+        
+        std::vector<int> frontier = {start};
+        long long frontierSize = 1;
+        long long frontierEdges = out.degree(start);             // m_f
+        long long unexploredEdges = out.edges() - in.degree(start);  // m_u
+        bool bottomUp = false;
+        
+        for (int level = 0; frontierSize > 0; level++) {
+            long long previousSize = frontierSize;
+            if (!bottomUp && frontierEdges > unexploredEdges / ALPHA) {
+                for (int w = 0; w < words; w++) {
+                    frontierBits[w].store(0, std::memory_order_relaxed);
+                }
+                for (int u : frontier) {
+                    frontierBits[u / 64].fetch_or(uint64_t(1) << (u % 64), std::memory_order_relaxed);
+                }
+                bottomUp = true;
+            }
+            
+            std::atomic<long long> cursor(0), nextSize(0), nextEdges(0), claimedEdges(0);
+            
+            if (bottomUp) {
+                // Threads own whole bitmap words, so plain stores suffice
+                runThreads(threads, [&](int) {
+                    long long found = 0, foundOut = 0, foundIn = 0;
+                    while (true) {
+                        long long first = cursor.fetch_add(BOTTOM_UP_BLOCK);
+                        if (first >= words) break;
+                        long long last = std::min<long long>(words, first + BOTTOM_UP_BLOCK);
+                        for (long long w = first; w < last; w++) {
+                            uint64_t seen = visited[w].load(std::memory_order_relaxed);
+                            uint64_t todo = ~seen;
+                            if (w == words - 1 && V % 64 != 0) {
+                                todo &= (uint64_t(1) << (V % 64)) - 1;
+                            }
+                            uint64_t reached = 0;
+                            while (todo) {
+                                int bit = __builtin_ctzll(todo);
+                                todo &= todo - 1;
+                                int v = w * 64 + bit;
+                                for (int u : in.neighbors(v)) {
+                                    if (frontierBits[u / 64].load(std::memory_order_relaxed) >> (u % 64) & 1) {
+                                        distance[v].store(level + 1, std::memory_order_relaxed);
+                                        parent[v].store(u, std::memory_order_relaxed);
+                                        reached |= uint64_t(1) << bit;
+                                        found++;
+                                        foundOut += out.degree(v);
+                                        foundIn += in.degree(v);
+                                        break;
+                                    }
+                                }
+                            }
+                            nextBits[w].store(reached, std::memory_order_relaxed);
+                            visited[w].store(seen | reached, std::memory_order_relaxed);
+                        }
+                    }
+                    nextSize += found;
+                    nextEdges += foundOut;
+                    claimedEdges += foundIn;
+                });
+                std::swap(frontierBits, nextBits);
+            } else {
+                std::vector<std::vector<int>> local(threads);
+                runThreads(threads, [&](int t) {
+                    std::vector<int>& queue = local[t];
+                    long long foundOut = 0, foundIn = 0;
+                    while (true) {
+                        long long first = cursor.fetch_add(TOP_DOWN_BLOCK);
+                        if (first >= frontierSize) break;
+                        long long last = std::min(frontierSize, first + TOP_DOWN_BLOCK);
+                        for (long long i = first; i < last; i++) {
+                            int u = frontier[i];
+                            for (int v : out.neighbors(u)) {
+                                int d = distance[v].load(std::memory_order_relaxed);
+                                if (d == -1 &&
+                                    distance[v].compare_exchange_strong(d, level + 1, std::memory_order_relaxed)) {
+                                    visited[v / 64].fetch_or(uint64_t(1) << (v % 64), std::memory_order_relaxed);
+                                    queue.push_back(v);
+                                    foundOut += out.degree(v);
+                                    foundIn += in.degree(v);
+                                    d = level + 1;
+                                }
+                                if (d == level + 1) {
+                                    atomicMin(parent[v], u);
+                                }
+                            }
+                        }
+                    }
+                    nextSize += queue.size();
+                    nextEdges += foundOut;
+                    claimedEdges += foundIn;
+                });
+                frontier.clear();
+                for (const std::vector<int>& queue : local) {
+                    frontier.insert(frontier.end(), queue.begin(), queue.end());
+                }
+            }
+            
+            frontierSize = nextSize;
+            frontierEdges = nextEdges;
+            unexploredEdges -= claimedEdges;
+            
+            if (bottomUp && frontierSize < V / BETA && frontierSize < previousSize) {
+                // Back to a queue, ascending, for top-down steps
+                frontier.clear();
+                for (int w = 0; w < words; w++) {
+                    uint64_t bits = frontierBits[w].load(std::memory_order_relaxed);
+                    while (bits) {
+                        frontier.push_back(w * 64 + __builtin_ctzll(bits));
+                        bits &= bits - 1;
+                    }
+                }
+                bottomUp = false;
+            }
+        }
+        
+        BFSTree tree{std::vector<int>(V), std::vector<int>(V)};
+        for (int v = 0; v < V; v++) {
+            tree.distance[v] = distance[v].load(std::memory_order_relaxed);
+            int p = parent[v].load(std::memory_order_relaxed);
+            tree.parent[v] = p == INT_MAX ? -1 : p;
+        }
+        return tree;
+    }
+    
+    // Shortest path read off the parallel BFS tree
+    std::vector<int> shortestPathParallel(int start, int end, int threads = 0) {
+        BFSTree tree = BFSParallel(start, threads);
+        std::vector<int> path;
+        if (tree.distance[end] == -1) return path;  // No path
+        
+        for (int v = end; v != -1; v = tree.parent[v]) {
+            path.push_back(v);
+        }
+        std::reverse(path.begin(), path.end());
+        
+        return path;
+    }
+    
+    // Multi-source BFS (MS-BFS, Then et al.)
+    // Time: O(D * (V + E) * W) for 64 * W sources over D levels, against
+    // O(64 * W * (V + E)) for separate runs; Space: O(V * W) words
+    // Runs a batch of sources at once. Bit i of a vertex's masks belongs to
+    // source i: seen marks the sources that reached the vertex, visit those
+    // that reached it in the current level. Each level makes one sweep over
+    // the vertices with a non-empty visit mask and ORs that mask into every
+    // out-neighbour, so one scan of a vertex's edges serves every source in
+    // the batch whose frontier holds it. W = 1 (64 sources) or 4 (256); the
+    // W-word loops vectorize.
+    // onReach(v, bits, level) reports the sources in bits[0..W) that reach v
+    // for the first time at this level, sources included at level 0.
+    template <int W, typename OnReach>
+    void multiSourceBFS(const int* sources, int count, OnReach onReach) {
+        const CSRGraph& graph = adj.graph();
+        std::vector<uint64_t> seen((size_t)V * W, 0), visit((size_t)V * W, 0), next((size_t)V * W, 0);
+        
+        for (int i = 0; i < count; i++) {
+            size_t slot = (size_t)sources[i] * W + i / 64;
+            seen[slot] |= uint64_t(1) << (i % 64);
+            visit[slot] |= uint64_t(1) << (i % 64);
+        }
+        for (int v = 0; v < V; v++) {
+            uint64_t any = 0;
+            for (int w = 0; w < W; w++) any |= visit[(size_t)v * W + w];
+            if (any) onReach(v, &visit[(size_t)v * W], 0);
+        }
+        
+        for (int level = 1; ; level++) {
+            for (int v = 0; v < V; v++) {
+                const uint64_t* current = &visit[(size_t)v * W];
+                uint64_t any = 0;
+                for (int w = 0; w < W; w++) any |= current[w];
+                if (!any) continue;
+                
+                for (int u : graph.neighbors(v)) {
+                    uint64_t* target = &next[(size_t)u * W];
+                    const uint64_t* known = &seen[(size_t)u * W];
+                    for (int w = 0; w < W; w++) {
+                        target[w] |= current[w] & ~known[w];
+                    }
+                }
+            }
+            
+            bool active = false;
+            for (int v = 0; v < V; v++) {
+                uint64_t* fresh = &next[(size_t)v * W];
+                uint64_t* known = &seen[(size_t)v * W];
+                uint64_t* current = &visit[(size_t)v * W];
+                uint64_t any = 0;
+                for (int w = 0; w < W; w++) {
+                    current[w] = fresh[w];
+                    known[w] |= fresh[w];
+                    any |= fresh[w];
+                    fresh[w] = 0;
+                }
+                if (any) {
+                    onReach(v, current, level);
+                    active = true;
+                }
+            }
+            if (!active) break;
+        }
+    }
+    
+    // Distances from many sources: result[i] is BFSDistance(sources[i])
+    // Sources run in batches of 256 (64 when fewer remain)
+    std::vector<std::vector<int>> BFSDistanceBatch(const std::vector<int>& sources) {
+        std::vector<std::vector<int>> result(sources.size(), std::vector<int>(V, -1));
+        for (size_t base = 0; base < sources.size(); ) {
+            int count = std::min<size_t>(256, sources.size() - base);
+            auto record = [&](int v, const uint64_t* bits, int level) {
+                for (int w = 0; w * 64 < count; w++) {
+                    for (uint64_t b = bits[w]; b; b &= b - 1) {
+                        result[base + w * 64 + __builtin_ctzll(b)][v] = level;
+                    }
+                }
+            };
+            if (count > 64) {
+                multiSourceBFS<4>(&sources[base], count, record);
+            } else {
+                multiSourceBFS<1>(&sources[base], count, record);
+            }
+            base += count;
+        }
+        return result;
+    }
+    
+    // Closeness centrality of each source: (reached - 1) / sum of distances
+    // over the vertices it reaches, 0 when it reaches nothing else. Needs
+    // O(V) memory per batch, not per source.
+    std::vector<double> closenessCentrality(const std::vector<int>& sources) {
+        std::vector<double> result(sources.size(), 0.0);
+        std::vector<long long> reached(sources.size(), 0), total(sources.size(), 0);
+        for (size_t base = 0; base < sources.size(); ) {
+            int count = std::min<size_t>(256, sources.size() - base);
+            auto record = [&](int, const uint64_t* bits, int level) {
+                for (int w = 0; w * 64 < count; w++) {
+                    for (uint64_t b = bits[w]; b; b &= b - 1) {
+                        size_t i = base + w * 64 + __builtin_ctzll(b);
+                        reached[i]++;
+                        total[i] += level;
+                    }
+                }
+            };
+            if (count > 64) {
+                multiSourceBFS<4>(&sources[base], count, record);
+            } else {
+                multiSourceBFS<1>(&sources[base], count, record);
+            }
+            base += count;
+        }
+        for (size_t i = 0; i < sources.size(); i++) {
+            if (total[i] > 0) result[i] = (double)(reached[i] - 1) / total[i];
+        }
+        return result;
+    }
 };
 
 int main() {
-    std::cout << \"=== Breadth-First Search (BFS) ===\" << std::endl;
-    std::cout << \"Time: O(V + E), Space: O(V)\" << std::endl << std::endl;
+    std::cout << "=== Breadth-First Search (BFS) ===" << std::endl;
+    std::cout << "Time: O(V + E), Space: O(V)" << std::endl << std::endl;
     
     Graph g(6);
     g.addEdge(0, 1);
@@ -147,15 +489,62 @@ int main() {
     
     g.BFS(0);
     
-    std::cout << \"\\nDistances from vertex 0:\" << std::endl;
+    std::cout << "\nDistances from vertex 0:" << std::endl;
     std::vector<int> distances = g.BFSDistance(0);
     for (int i = 0; i < distances.size(); i++) {
-        std::cout << \"  To \" << i << \": \" << distances[i] << std::endl;
+        std::cout << "  To " << i << ": " << distances[i] << std::endl;
     }
     
-    std::cout << \"\\nShortest path from 0 to 5: \";
+    std::cout << "\nShortest path from 0 to 5: ";
     std::vector<int> path = g.shortestPath(0, 5);
-    for (int v : path) std::cout << v << \" \";
+    for (int v : path) std::cout << v << " ";
+    std::cout << std::endl;
+    
+    std::cout << "Shortest path from 0 to 5 (parallel): ";
+    for (int v : g.shortestPathParallel(0, 5)) std::cout << v << " ";
+    std::cout << std::endl;
+    
+    // Low-diameter random graph: the middle levels run bottom-up
+    std::cout << "\n=== Direction-optimizing BFS ===" << std::endl;
+    int n = 1 << 18;
+    Graph social(n);
+    uint32_t state = 2024;
+    for (int u = 0; u < n; u++) {
+        for (int k = 0; k < 16; k++) {
+            state = state * 1103515245 + 12345;
+            // Squaring the draw skews edges toward low-numbered hubs
+            uint64_t r = state >> 8;
+            social.addEdge(u, (int)(r * r % ((uint64_t)n * n) / n));
+        }
+    }
+    BFSTree tree = social.BFSParallel(0);
+    std::vector<int> reference = social.BFSDistance(0);
+    int reached = 0, depth = 0;
+    for (int v = 0; v < n; v++) {
+        if (tree.distance[v] >= 0) reached++;
+        depth = std::max(depth, tree.distance[v]);
+    }
+    std::cout << "Vertices: " << n << ", edges: " << 16 * n << std::endl;
+    std::cout << "Reached: " << reached << ", depth: " << depth << std::endl;
+    std::cout << "Distances match serial BFS: "
+              << (tree.distance == reference ? "Yes" : "No") << std::endl;
+    
+    // 300 sources: one 256-wide batch and one 64-wide batch
+    std::cout << "\n=== Multi-source BFS ===" << std::endl;
+    std::vector<int> sources;
+    for (int i = 0; i < 300; i++) {
+        sources.push_back((int)((long long)i * 7919 % n));
+    }
+    std::vector<std::vector<int>> batch = social.BFSDistanceBatch(sources);
+    bool batchMatches = true;
+    for (int i = 0; i < 300; i += 37) {
+        batchMatches &= batch[i] == social.BFSDistance(sources[i]);
+    }
+    std::cout << "Sources: " << sources.size() << std::endl;
+    std::cout << "Distances match single-source BFS: " << (batchMatches ? "Yes" : "No") << std::endl;
+    std::vector<double> closeness = social.closenessCentrality(sources);
+    std::cout << "Closeness of first sources: ";
+    for (int i = 0; i < 4; i++) std::cout << closeness[i] << " ";
     std::cout << std::endl;
     
     return 0;
@@ -1,27 +1,30 @@
 #include <iostream>
 #include <vector>
 #include <queue>
+#include "csr.h"
 
 // Bipartite Graph Check
 // A graph is bipartite if it can be colored with 2 colors
 // Time Complexity: O(V + E)
 // Space Complexity: O(V)
+// Neighbours are scanned from a CSR graph (csr.h), one contiguous range per
+// vertex.
 
 class Graph {
 private:
     int V;
-    std::vector<std::vector<int>> adj;
-    
+    CSRBuilder adj;  // Edge list, frozen to CSR on the first query
+
 public:
     Graph(int vertices) : V(vertices), adj(vertices) {}
     
     void addEdge(int u, int v) {
-        adj[u].push_back(v);
-        adj[v].push_back(u);
+        adj.addUndirectedEdge(u, v);
     }
     
     // BFS-based bipartite check
     bool isBipartiteBFS(int start, std::vector<int>& color) {
+        const CSRGraph& graph = adj.graph();
         std::queue<int> q;
         q.push(start);
         color[start] = 0;
@@ -30,7 +33,7 @@ public:
             int u = q.front();
             q.pop();
             
-            for (int v : adj[u]) {
+            for (int v : graph.neighbors(u)) {
                 if (color[v] == -1) {
                     color[v] = 1 - color[u];
                     q.push(v);
@@ -46,7 +49,7 @@ public:
     bool isBipartiteDFS(int u, int c, std::vector<int>& color) {
         color[u] = c;
         
-        for (int v : adj[u]) {
+        for (int v : adj.graph().neighbors(u)) {
             if (color[v] == -1) {
                 if (!isBipartiteDFS(v, 1 - c, color))
                     return false;
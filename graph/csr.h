@@ -0,0 +1,232 @@
+#ifndef CSR_H
+#define CSR_H
+
+#include <vector>
+#include <thread>
+#include <algorithm>
+
+// Compressed Sparse Row (CSR) graph
+// The out-edges of vertex u occupy positions offsets[u] .. offsets[u+1]-1 of
+// one targets array, with weights (when the graph has them) in a parallel
+// array at the same positions:
+//   offsets: [0, 2, 3, 3, ...]      V + 1 entries
+//   targets: [1, 2, 3, ...]         E entries
+//   weights: [4, 2, 8, ...]         E entries or empty
+// A neighbour scan is a linear walk over contiguous memory instead of
+// chasing list nodes or separately allocated vectors, and the whole graph
+// is three allocations.
+
+struct CSREdge {
+    int from;
+    int to;
+    int weight;
+};
+
+class CSRGraph {
+public:
+    // Contiguous [first, last) view usable in range-for
+    template <typename T>
+    struct Range {
+        const T* first;
+        const T* last;
+        
+        const T* begin() const { return first; }
+        const T* end() const { return last; }
+        int size() const { return last - first; }
+        const T& operator[](int i) const { return first[i]; }
+    };
+    
+    CSRGraph() : V(0), offsets(1, 0) {}
+    
+    int vertices() const { return V; }
+    int edges() const { return targets.size(); }
+    bool weighted() const { return !weights.empty(); }
+    int degree(int u) const { return offsets[u + 1] - offsets[u]; }
+    
+    Range<int> neighbors(int u) const {
+        return {targets.data() + offsets[u], targets.data() + offsets[u + 1]};
+    }
+    
+    // Weights of u's out-edges, in the same order as neighbors(u)
+    Range<int> weightsOf(int u) const {
+        return {weights.data() + offsets[u], weights.data() + offsets[u + 1]};
+    }
+    
+    // Raw arrays for algorithms that index edges directly
+    const std::vector<int>& offsetArray() const { return offsets; }
+    const std::vector<int>& targetArray() const { return targets; }
+    const std::vector<int>& weightArray() const { return weights; }
+    
+    // Counting sort of an edge list by source vertex
+    // Time: O(V + E / threads), Space: O(V + E)
+    // Each thread counts the sources in its slice of the edge list, a prefix
+    // sum over (vertex, thread) gives every thread its own write position
+    // inside each vertex's block, and the threads then scatter their slices
+    // without synchronization. Edges of a vertex keep their input order, so
+    // the result is identical for any thread count.
+    // The per-thread counters cost V ints each, so threads are capped at
+    // E / V: a sparse graph is built by few threads rather than spending
+    // more on counters than on the edges themselves. The prefix sum runs in
+    // parallel over vertex ranges.
+    static CSRGraph fromEdges(int vertexCount, const std::vector<CSREdge>& edgeList,
+                              bool withWeights, int threads = 0) {
+        const size_t PARALLEL_EDGES = 1 << 16;
+        if (threads <= 0) {
+            threads = std::max(1u, std::thread::hardware_concurrency());
+        }
+        size_t E = edgeList.size();
+        if (E < PARALLEL_EDGES) threads = 1;
+        threads = (int)std::max<size_t>(1, std::min<size_t>(threads, E / std::max(1, vertexCount)));
+        
+        CSRGraph g;
+        g.V = vertexCount;
+        g.offsets.assign(vertexCount + 1, 0);
+        g.targets.resize(E);
+        if (withWeights) g.weights.resize(E);
+        
+        size_t slice = (E + threads - 1) / threads;
+        int vertexSlice = (vertexCount + threads - 1) / threads;
+        std::vector<std::vector<int>> cursor(threads);
+        std::vector<int> rangeStart(threads + 1, 0);
+        
+        auto runThreads = [threads](auto fn) {
+            std::vector<std::thread> pool;
+            for (int t = 1; t < threads; t++) {
+                pool.emplace_back(fn, t);
+            }
+            fn(0);
+            for (std::thread& worker : pool) {
+                worker.join();
+            }
+        };
+        
+        // 1. Per-thread source counts
+        runThreads([&](int t) {
+            size_t from = std::min(E, t * slice), to = std::min(E, from + slice);
+            std::vector<int>& count = cursor[t];
+            count.assign(vertexCount, 0);
+            for (size_t e = from; e < to; e++) {
+                count[edgeList[e].from]++;
+            }
+        });
+        
+        // 2. Exclusive prefix over threads within each vertex, leaving the
+        //    degree in offsets[u + 1]; then a prefix over vertices, first
+        //    inside each vertex range and then across the ranges
+        runThreads([&](int t) {
+            int from = std::min(vertexCount, t * vertexSlice), to = std::min(vertexCount, from + vertexSlice);
+            int total = 0;
+            for (int u = from; u < to; u++) {
+                int running = 0;
+                for (int s = 0; s < threads; s++) {
+                    int count = cursor[s][u];
+                    cursor[s][u] = running;
+                    running += count;
+                }
+                g.offsets[u + 1] = running;
+                total += running;
+            }
+            rangeStart[t + 1] = total;
+        });
+        for (int t = 0; t < threads; t++) {
+            rangeStart[t + 1] += rangeStart[t];
+        }
+        runThreads([&](int t) {
+            int from = std::min(vertexCount, t * vertexSlice), to = std::min(vertexCount, from + vertexSlice);
+            int running = rangeStart[t];
+            for (int u = from; u < to; u++) {
+                running += g.offsets[u + 1];
+                g.offsets[u + 1] = running;
+            }
+        });
+        
+        // 3. Scatter
+        runThreads([&](int t) {
+            size_t from = std::min(E, t * slice), to = std::min(E, from + slice);
+            std::vector<int>& position = cursor[t];
+            for (size_t e = from; e < to; e++) {
+                const CSREdge& edge = edgeList[e];
+                int slot = g.offsets[edge.from] + position[edge.from]++;
+                g.targets[slot] = edge.to;
+                if (withWeights) g.weights[slot] = edge.weight;
+            }
+        });
+        
+        return g;
+    }
+    
+    // Same graph with every edge reversed
+    CSRGraph transpose(int threads = 0) const {
+        std::vector<CSREdge> reversed;
+        reversed.reserve(edges());
+        for (int u = 0; u < V; u++) {
+            for (int e = offsets[u]; e < offsets[u + 1]; e++) {
+                reversed.push_back({targets[e], u, weighted() ? weights[e] : 1});
+            }
+        }
+        return fromEdges(V, reversed, weighted(), threads);
+    }
+
+private:
+    int V;
+    std::vector<int> offsets;
+    std::vector<int> targets;
+    std::vector<int> weights;
+};
+
+// Edge list that freezes into a CSRGraph when read
+// Graph classes keep their addEdge() interface on top of this; the first
+// query builds the CSR arrays, and adding an edge afterwards only marks them
+// stale for the next query. Once frozen, the edge list is released: the CSR
+// arrays hold every edge, and keeping both would double the memory of a
+// large graph. A rebuild unpacks the frozen edges in front of the new ones.
+class CSRBuilder {
+private:
+    int V;
+    bool hasWeights;
+    std::vector<CSREdge> edgeList;  // Edges added since the last freeze
+    CSRGraph frozen;
+    bool stale = true;
+
+public:
+    explicit CSRBuilder(int vertices, bool weighted = false)
+        : V(vertices), hasWeights(weighted) {}
+    
+    void addEdge(int u, int v, int weight = 1) {
+        edgeList.push_back({u, v, weight});
+        stale = true;
+    }
+    
+    void addUndirectedEdge(int u, int v, int weight = 1) {
+        addEdge(u, v, weight);
+        addEdge(v, u, weight);
+    }
+    
+    int vertices() const { return V; }
+    
+    const CSRGraph& graph(int threads = 0) {
+        if (stale) {
+            // fromEdges keeps each vertex's edges in input order, so frozen
+            // edges followed by new ones give the same CSR as the full list
+            if (frozen.edges() > 0) {
+                std::vector<CSREdge> all;
+                all.reserve(frozen.edges() + edgeList.size());
+                for (int u = 0; u < frozen.vertices(); u++) {
+                    CSRGraph::Range<int> targets = frozen.neighbors(u);
+                    for (int e = 0; e < targets.size(); e++) {
+                        all.push_back({u, targets[e], hasWeights ? frozen.weightsOf(u)[e] : 1});
+                    }
+                }
+                all.insert(all.end(), edgeList.begin(), edgeList.end());
+                edgeList.swap(all);
+            }
+            frozen = CSRGraph::fromEdges(V, edgeList, hasWeights, threads);
+            edgeList.clear();
+            edgeList.shrink_to_fit();
+            stale = false;
+        }
+        return frozen;
+    }
+};
+
+#endif
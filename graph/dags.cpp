@@ -3,32 +3,38 @@
 #include <queue>
 #include <stack>
 #include <algorithm>
+#include <climits>
+#include <stdexcept>
+#include "csr.h"
+#include "dagschedule.h"
 
 // Directed Acyclic Graph (DAG) Algorithms
 // Time Complexity: O(V + E)
 // Space Complexity: O(V)
+// Neighbours are scanned from a CSR graph (csr.h), one contiguous range per
+// vertex. Parallel levels and the task executor live in dagschedule.h.
 
 class DAG {
 private:
     int V;
-    std::vector<std::vector<int>> adj;
+    CSRBuilder adj;  // Edge list, frozen to CSR on the first query
     
     void topologicalSortUtil(int v, std::vector<bool>& visited, std::stack<int>& Stack) {
         visited[v] = true;
         
-        for (int u : adj[v]) {
+        for (int u : adj.graph().neighbors(v)) {
             if (!visited[u])
                 topologicalSortUtil(u, visited, Stack);
         }
         
         Stack.push(v);
     }
-    
+
 public:
     DAG(int vertices) : V(vertices), adj(vertices) {}
     
     void addEdge(int u, int v) {
-        adj[u].push_back(v);
+        adj.addEdge(u, v);
     }
     
     // Topological Sort using DFS
@@ -51,10 +57,11 @@ public:
     
     // Topological Sort using Kahn's Algorithm (BFS)
     std::vector<int> topologicalSortKahn() {
+        const CSRGraph& graph = adj.graph();
         std::vector<int> indegree(V, 0);
         
         for (int u = 0; u < V; u++) {
-            for (int v : adj[u]) {
+            for (int v : graph.neighbors(u)) {
                 indegree[v]++;
             }
         }
@@ -71,7 +78,7 @@ public:
             q.pop();
             result.push_back(u);
             
-            for (int v : adj[u]) {
+            for (int v : graph.neighbors(u)) {
                 if (--indegree[v] == 0)
                     q.push(v);
             }
@@ -85,15 +92,31 @@ public:
         return result;
     }
     
+    // Kahn's algorithm a whole level at a time (dagschedule.h)
+    TopologicalLevels topologicalSortParallel(int threads = 0) {
+        return topologicalLevels(adj.graph(), threads);
+    }
+    
+    // task(v) runs once every u with an edge u -> v has finished
+    template <typename Task>
+    void runTasks(Task task, int threads = 0) {
+        DAGExecutor(threads).run(adj.graph(), task);
+    }
+    
+    const CSRGraph& csr() {
+        return adj.graph();
+    }
+    
     // Longest path in DAG
     std::vector<int> longestPath(int start) {
+        const CSRGraph& graph = adj.graph();
         std::vector<int> topo = topologicalSortDFS();
         std::vector<int> dist(V, INT_MIN);
         dist[start] = 0;
         
         for (int u : topo) {
             if (dist[u] != INT_MIN) {
-                for (int v : adj[u]) {
+                for (int v : graph.neighbors(u)) {
                     dist[v] = std::max(dist[v], dist[u] + 1);
                 }
             }
@@ -109,13 +132,14 @@ public:
     
     // Count paths from source to destination
     int countPaths(int src, int dest) {
+        const CSRGraph& graph = adj.graph();
         std::vector<int> topo = topologicalSortDFS();
         std::vector<int> pathCount(V, 0);
         pathCount[src] = 1;
         
         for (int u : topo) {
             if (pathCount[u] > 0) {
-                for (int v : adj[u]) {
+                for (int v : graph.neighbors(u)) {
                     pathCount[v] += pathCount[u];
                 }
             }
@@ -147,6 +171,17 @@ int main() {
     for (int v : topo2) std::cout << v << " ";
     std::cout << std::endl;
     
+    std::cout << "Topological levels (parallel Kahn): ";
+    TopologicalLevels levels = g.topologicalSortParallel();
+    for (int k = 0; k < levels.levels(); k++) {
+        std::cout << "{ ";
+        for (int i = levels.levelStart[k]; i < levels.levelStart[k + 1]; i++) {
+            std::cout << levels.order[i] << " ";
+        }
+        std::cout << "} ";
+    }
+    std::cout << std::endl;
+    
     std::cout << "\nLongest path from vertex 5:" << std::endl;
     std::vector<int> dist = g.longestPath(5);
     for (int i = 0; i < dist.size(); i++) {
@@ -156,6 +191,47 @@ int main() {
     
     std::cout << "\nNumber of paths from 5 to 1: " << g.countPaths(5, 1) << std::endl;
     
+    // Build-graph scheduling: each task's depth is one more than its
+    // deepest dependency, which is only right if dependencies ran first
+    std::cout << "\n=== DAG Task Executor ===" << std::endl;
+    int n = 200000;
+    DAG build(n);
+    uint32_t state = 17;
+    for (int v = 1; v < n; v++) {
+        for (int k = 0; k < 3; k++) {
+            state = state * 1103515245 + 12345;
+            int span = std::min(v, 1000);
+            build.addEdge(v - 1 - (int)((state >> 8) % span), v);
+        }
+    }
+    CSRGraph dependencies = build.csr().transpose();
+    std::vector<int> depth(n, 0);
+    build.runTasks([&](int v) {
+        for (int u : dependencies.neighbors(v)) {
+            depth[v] = std::max(depth[v], depth[u] + 1);
+        }
+    });
+    
+    TopologicalLevels buildLevels = build.topologicalSortParallel();
+    bool matches = (int)buildLevels.order.size() == n;
+    for (int k = 0; k < buildLevels.levels(); k++) {
+        for (int i = buildLevels.levelStart[k]; i < buildLevels.levelStart[k + 1]; i++) {
+            matches &= depth[buildLevels.order[i]] == k;
+        }
+    }
+    std::cout << n << " tasks in " << buildLevels.levels() << " levels" << std::endl;
+    std::cout << "Task depths match Kahn levels: " << (matches ? "Yes" : "No") << std::endl;
+    
+    DAG loop(3);
+    loop.addEdge(0, 1);
+    loop.addEdge(1, 2);
+    loop.addEdge(2, 1);
+    try {
+        loop.runTasks([](int) {});
+    } catch (const std::runtime_error& e) {
+        std::cout << "Cyclic task graph: " << e.what() << std::endl;
+    }
+    
     std::cout << "\nApplications:" << std::endl;
     std::cout << "  - Task scheduling with dependencies" << std::endl;
     std::cout << "  - Build systems (makefiles)" << std::endl;
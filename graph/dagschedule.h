@@ -0,0 +1,242 @@
+#ifndef DAGSCHEDULE_H
+#define DAGSCHEDULE_H
+
+#include <vector>
+#include <deque>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <thread>
+#include <exception>
+#include <stdexcept>
+#include <algorithm>
+#include "csr.h"
+#include "threadpool.h"
+
+// Parallel Topological Sorting and DAG Scheduling
+// Kahn's algorithm peels vertices whose in-degree has dropped to zero. All
+// vertices that reach zero in the same round are independent of each other,
+// so instead of a queue of single vertices both tools here work on many
+// ready vertices at once:
+//   - topologicalLevels(): whole rounds ("levels") processed in parallel,
+//     with the order and the level boundaries returned
+//   - DAGExecutor: user callbacks run as soon as their own dependencies
+//     finish, without waiting for the rest of a level
+
+// order[levelStart[k] .. levelStart[k + 1]) is level k: vertices whose
+// longest chain of predecessors has k edges. Within a level the order
+// depends on thread timing. On a cyclic graph order stops short of V.
+struct TopologicalLevels {
+    std::vector<int> order;
+    std::vector<int> levelStart{0};
+    
+    int levels() const { return levelStart.size() - 1; }
+};
+
+// Level-synchronous Kahn's algorithm
+// Time: O((V + E) / threads + levels), Space: O(V)
+// Threads grab blocks of the current level, decrement successors' in-degrees
+// atomically, and the thread whose decrement reaches zero owns that vertex
+// for the next level. The threads start once (threadpool.h) and sleep
+// between levels.
+inline TopologicalLevels topologicalLevels(const CSRGraph& graph, int threads = 0) {
+    const int BLOCK = 256;            // Vertices per grab
+    const int PARALLEL_ITEMS = 4096;  // Smaller levels run on one thread
+    if (threads <= 0) {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    int V = graph.vertices();
+    
+    // One pool for the whole sort: a deep DAG has thousands of levels
+    WorkerPool pool(threads);
+    auto parallelFor = [&pool](long long count, auto fn) {
+        pool.parallelFor(count, fn, BLOCK, PARALLEL_ITEMS);
+    };
+    
+    std::vector<std::atomic<int>> inDegree(V);
+    parallelFor(V, [&](long long u, int) {
+        inDegree[u].store(0, std::memory_order_relaxed);
+    });
+    parallelFor(V, [&](long long u, int) {
+        for (int v : graph.neighbors(u)) {
+            inDegree[v].fetch_add(1, std::memory_order_relaxed);
+        }
+    });
+    
+    TopologicalLevels result;
+    result.order.reserve(V);
+    std::vector<std::vector<int>> local(threads);
+    parallelFor(V, [&](long long u, int t) {
+        if (inDegree[u].load(std::memory_order_relaxed) == 0) local[t].push_back(u);
+    });
+    
+    while (true) {
+        int first = result.order.size();
+        for (std::vector<int>& part : local) {
+            result.order.insert(result.order.end(), part.begin(), part.end());
+            part.clear();
+        }
+        int last = result.order.size();
+        if (first == last) break;
+        result.levelStart.push_back(last);
+        
+        parallelFor(last - first, [&](long long i, int t) {
+            for (int v : graph.neighbors(result.order[first + i])) {
+                if (inDegree[v].fetch_sub(1, std::memory_order_relaxed) == 1) {
+                    local[t].push_back(v);
+                }
+            }
+        });
+    }
+    return result;
+}
+
+// DAG Task Executor
+// run(graph, task) calls task(v) for every vertex, each only after task(u)
+// has returned for every edge u -> v. Effects of a finished task are
+// visible to the tasks that depend on it.
+// Work stealing: each worker owns a deque. A finished task pushes the
+// successors it released onto the back of its own deque and the worker
+// pops from the back, so a dependent chain stays on one warm core. An idle
+// worker steals from the front of another worker's deque, taking the
+// oldest, usually largest, pieces of work.
+// A worker that finds every deque empty sleeps on a condition variable
+// until a task is released or the run ends, so one long task does not keep
+// the other cores spinning. The workers themselves are a WorkerPool started
+// with the executor and reused by every run().
+// If a task throws, no further tasks start and run() rethrows the first
+// exception once running tasks finish. A cycle is reported as
+// std::runtime_error after every runnable task has run.
+class DAGExecutor {
+private:
+    struct WorkQueue {
+        std::mutex lock;
+        std::deque<int> tasks;
+    };
+    
+    int threads;
+    WorkerPool pool;
+
+public:
+    explicit DAGExecutor(int threadCount = 0)
+        : threads(threadCount > 0 ? threadCount : std::max(1u, std::thread::hardware_concurrency())),
+          pool(threads) {}
+    
+    template <typename Task>
+    void run(const CSRGraph& graph, Task task) {
+        int V = graph.vertices();
+        std::vector<std::atomic<int>> inDegree(V);
+        for (int v = 0; v < V; v++) {
+            inDegree[v].store(0, std::memory_order_relaxed);
+        }
+        for (int u = 0; u < V; u++) {
+            for (int v : graph.neighbors(u)) {
+                inDegree[v].fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+        
+        std::vector<WorkQueue> queues(threads);
+        // Tasks queued or running; at zero no task can ever become ready
+        std::atomic<int> inFlight(0);
+        std::atomic<int> queued(0);  // Tasks sitting in some deque
+        std::atomic<int> finished(0);
+        std::atomic<bool> failed(false);
+        std::exception_ptr error;
+        std::mutex errorLock;
+        std::mutex idleLock;
+        std::condition_variable idle;
+        
+        // Waiters test their condition under idleLock, so taking it before
+        // notifying means a sleeper cannot miss the change
+        auto wakeOne = [&] {
+            std::lock_guard<std::mutex> guard(idleLock);
+            idle.notify_one();
+        };
+        auto wakeAll = [&] {
+            std::lock_guard<std::mutex> guard(idleLock);
+            idle.notify_all();
+        };
+        
+        int next = 0;
+        for (int v = 0; v < V; v++) {
+            if (inDegree[v].load(std::memory_order_relaxed) == 0) {
+                queues[next].tasks.push_back(v);
+                next = (next + 1) % threads;
+                inFlight++;
+                queued++;
+            }
+        }
+        
+        // Own deque from the back, else steal from the front of another
+        auto take = [&](int self) {
+            {
+                std::lock_guard<std::mutex> guard(queues[self].lock);
+                if (!queues[self].tasks.empty()) {
+                    int v = queues[self].tasks.back();
+                    queues[self].tasks.pop_back();
+                    queued--;
+                    return v;
+                }
+            }
+            for (int i = 1; i < threads; i++) {
+                WorkQueue& victim = queues[(self + i) % threads];
+                std::lock_guard<std::mutex> guard(victim.lock);
+                if (!victim.tasks.empty()) {
+                    int v = victim.tasks.front();
+                    victim.tasks.pop_front();
+                    queued--;
+                    return v;
+                }
+            }
+            return -1;
+        };
+        
+        auto worker = [&](int self) {
+            while (!failed.load() && inFlight.load() > 0) {
+                int v = take(self);
+                if (v == -1) {
+                    std::unique_lock<std::mutex> guard(idleLock);
+                    idle.wait(guard, [&] {
+                        return failed.load() || inFlight.load() == 0 || queued.load() > 0;
+                    });
+                    continue;
+                }
+                
+                try {
+                    task(v);
+                } catch (...) {
+                    std::lock_guard<std::mutex> guard(errorLock);
+                    if (!error) error = std::current_exception();
+                    failed.store(true);
+                }
+                
+                if (failed.load()) {
+                    wakeAll();
+                } else {
+                    finished++;
+                    for (int w : graph.neighbors(v)) {
+                        if (inDegree[w].fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                            inFlight++;
+                            {
+                                std::lock_guard<std::mutex> guard(queues[self].lock);
+                                queues[self].tasks.push_back(w);
+                            }
+                            queued++;
+                            wakeOne();
+                        }
+                    }
+                }
+                if (--inFlight == 0) wakeAll();
+            }
+        };
+        
+        pool.run(worker);
+        
+        if (error) std::rethrow_exception(error);
+        if (finished.load() != V) {
+            throw std::runtime_error("task graph has a cycle");
+        }
+    }
+};
+
+#endif
@@ -1,50 +1,53 @@
 #include <iostream>
 #include <vector>
-#include <list>
+#include "csr.h"
 #include <stack>
 
 // Depth-First Search (DFS)
 // Time Complexity: O(V + E)
 // Space Complexity: O(V)
+// Neighbours are scanned from a CSR graph (csr.h), one contiguous range per
+// vertex.
 
 class Graph {
 private:
     int V;
-    std::vector<std::list<int>> adj;
+    CSRBuilder adj;  // Edge list, frozen to CSR on the first query
     
     void DFSUtil(int vertex, std::vector<bool>& visited) {
         visited[vertex] = true;
-        std::cout << vertex << \" \";
+        std::cout << vertex << " ";
         
-        for (int neighbor : adj[vertex]) {
+        for (int neighbor : adj.graph().neighbors(vertex)) {
             if (!visited[neighbor]) {
                 DFSUtil(neighbor, visited);
             }
         }
     }
-    
+
 public:
     Graph(int vertices) : V(vertices), adj(vertices) {}
     
     void addEdge(int u, int v) {
-        adj[u].push_back(v);
+        adj.addEdge(u, v);
     }
     
     // Recursive DFS
     void DFS(int start) {
         std::vector<bool> visited(V, false);
-        std::cout << \"DFS (recursive) from \" << start << \": \";
+        std::cout << "DFS (recursive) from " << start << ": ";
         DFSUtil(start, visited);
         std::cout << std::endl;
     }
     
     // Iterative DFS using stack
     void DFSIterative(int start) {
+        const CSRGraph& graph = adj.graph();
         std::vector<bool> visited(V, false);
         std::stack<int> stack;
         
         stack.push(start);
-        std::cout << \"DFS (iterative) from \" << start << \": \";
+        std::cout << "DFS (iterative) from " << start << ": ";
         
         while (!stack.empty()) {
             int vertex = stack.top();
@@ -52,12 +55,13 @@ public:
             
             if (!visited[vertex]) {
                 visited[vertex] = true;
-                std::cout << vertex << \" \";
+                std::cout << vertex << " ";
                 
                 // Push neighbors in reverse to match recursive order
-                for (auto it = adj[vertex].rbegin(); it != adj[vertex].rend(); ++it) {
-                    if (!visited[*it]) {
-                        stack.push(*it);
+                CSRGraph::Range<int> neighbors = graph.neighbors(vertex);
+                for (int i = neighbors.size() - 1; i >= 0; i--) {
+                    if (!visited[neighbors[i]]) {
+                        stack.push(neighbors[i]);
                     }
                 }
             }
@@ -68,7 +72,7 @@ public:
     // DFS for all vertices (handles disconnected graph)
     void DFSComplete() {
         std::vector<bool> visited(V, false);
-        std::cout << \"Complete DFS: \";
+        std::cout << "Complete DFS: ";
         
         for (int v = 0; v < V; v++) {
             if (!visited[v]) {
@@ -83,7 +87,7 @@ public:
         visited[v] = true;
         recStack[v] = true;
         
-        for (int neighbor : adj[v]) {
+        for (int neighbor : adj.graph().neighbors(v)) {
             if (!visited[neighbor]) {
                 if (hasCycleUtil(neighbor, visited, recStack)) {
                     return true;
@@ -128,8 +132,8 @@ public:
 };
 
 int main() {
-    std::cout << \"=== Depth-First Search (DFS) ===\" << std::endl;
-    std::cout << \"Time: O(V + E), Space: O(V)\" << std::endl << std::endl;
+    std::cout << "=== Depth-First Search (DFS) ===" << std::endl;
+    std::cout << "Time: O(V + E), Space: O(V)" << std::endl << std::endl;
     
     Graph g(6);
     g.addEdge(0, 1);
@@ -143,14 +147,14 @@ int main() {
     g.DFS(0);
     g.DFSIterative(0);
     
-    std::cout << \"\\n=== Cycle Detection ===\" << std::endl;
+    std::cout << "\n=== Cycle Detection ===" << std::endl;
     Graph g2(4);
     g2.addEdge(0, 1);
     g2.addEdge(1, 2);
     g2.addEdge(2, 3);
     g2.addEdge(3, 1);  // Creates cycle
     
-    std::cout << \"Has cycle: \" << (g2.hasCycle() ? \"Yes\" : \"No\") << std::endl;
+    std::cout << "Has cycle: " << (g2.hasCycle() ? "Yes" : "No") << std::endl;
     
     return 0;
 }
@@ -2,24 +2,138 @@
 #include <vector>
 #include <queue>
 #include <climits>
+#include <cstdlib>
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <string>
+#include <fstream>
+#include <filesystem>
+#include <stdexcept>
+#include "csr.h"
+#include "monotonequeue.h"
 
 // Dijkstra's Shortest Path Algorithm
 // Time Complexity: O((V + E) log V) with priority queue
 // Space Complexity: O(V)
+// Edges are scanned from a CSR graph (csr.h): each vertex's targets and
+// weights are contiguous ranges of two parallel arrays.
+
+// Answer to one point-to-point query
+// distance = LLONG_MAX and an empty path when end is unreachable; settled
+// counts the vertices the search finalized, a measure of its cost
+struct RouteResult {
+    long long distance;
+    std::vector<int> path;
+    int settled;
+};
 
 class Graph {
 private:
     int V;
-    std::vector<std::vector<std::pair<int, int>>> adj;  // {vertex, weight}
+    CSRBuilder adj;  // Weighted edge list, frozen to CSR on the first query
+    CSRGraph reverse;  // In-edges for backward searches
+    bool reverseStale = true;
+    
+    // Delta-stepping's copy of the edges, light ones first per vertex, kept
+    // for the delta it was split at so repeated queries skip the O(E) pass
+    struct SteppingEdges {
+        long long maxWeight = 1;
+        long long delta = 0;  // 0: not split yet
+        std::vector<int> target, weight, lightEnd;
+    };
+    SteppingEdges stepping;
+    bool steppingStale = true;
+    
+    // ALT landmarks: fromLandmark[i][v] = d(L_i, v), toLandmark[i][v] = d(v, L_i)
+    std::vector<int> landmarks;
+    std::vector<std::vector<long long>> fromLandmark, toLandmark;
+    
+    const CSRGraph& reverseGraph() {
+        if (reverseStale) {
+            reverse = adj.graph().transpose();
+            reverseStale = false;
+        }
+        return reverse;
+    }
+    
+    // Single-source distances over any CSR graph
+    template <typename Queue>
+    static std::vector<long long> searchFrom(const CSRGraph& graph, int start) {
+        long long maxWeight = 0;
+        for (int w : graph.weightArray()) maxWeight = std::max<long long>(maxWeight, w);
+        
+        std::vector<long long> dist(graph.vertices(), LLONG_MAX);
+        Queue queue(graph.vertices(), maxWeight);
+        dist[start] = 0;
+        queue.push(start, 0);
+        
+        while (!queue.empty()) {
+            auto [d, u] = queue.pop();
+            CSRGraph::Range<int> targets = graph.neighbors(u);
+            CSRGraph::Range<int> weights = graph.weightsOf(u);
+            for (int e = 0; e < targets.size(); e++) {
+                int v = targets[e];
+                if (d + weights[e] < dist[v]) {
+                    dist[v] = d + weights[e];
+                    queue.push(v, dist[v]);
+                }
+            }
+        }
+        
+        return dist;
+    }
     
+    static std::vector<int> tracePath(const std::vector<int>& parent, int end) {
+        std::vector<int> path;
+        for (int v = end; v != -1; v = parent[v]) {
+            path.push_back(v);
+        }
+        std::reverse(path.begin(), path.end());
+        return path;
+    }
+    
+    template <typename Fn>
+    static void runThreads(int threads, Fn fn) {
+        std::vector<std::thread> pool;
+        for (int t = 1; t < threads; t++) {
+            pool.emplace_back(fn, t);
+        }
+        fn(0);
+        for (std::thread& worker : pool) {
+            worker.join();
+        }
+    }
+    
+    // Lower dist to value; true when this call lowered it
+    static bool atomicRelax(std::atomic<long long>& dist, long long value) {
+        long long current = dist.load(std::memory_order_relaxed);
+        while (value < current) {
+            if (dist.compare_exchange_weak(current, value, std::memory_order_relaxed)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
 public:
-    Graph(int vertices) : V(vertices), adj(vertices) {}
+    Graph(int vertices) : V(vertices), adj(vertices, true) {}
+    
+    int vertices() const { return V; }
+    const CSRGraph& csr() { return adj.graph(); }
     
     void addEdge(int u, int v, int weight) {
-        adj[u].push_back({v, weight});
+        adj.addEdge(u, v, weight);
+        reverseStale = true;
+        steppingStale = true;
+        // A new edge can shorten distances and break the landmark bounds
+        landmarks.clear();
+        fromLandmark.clear();
+        toLandmark.clear();
     }
     
     std::vector<int> dijkstra(int start) {
+        const CSRGraph& graph = adj.graph();
         std::vector<int> dist(V, INT_MAX);
         std::vector<int> parent(V, -1);
         
@@ -38,7 +152,10 @@ public:
             
             if (d > dist[u]) continue;  // Already processed
             
-            for (auto& [v, weight] : adj[u]) {
+            CSRGraph::Range<int> targets = graph.neighbors(u);
+            CSRGraph::Range<int> weights = graph.weightsOf(u);
+            for (int e = 0; e < targets.size(); e++) {
+                int v = targets[e], weight = weights[e];
                 if (dist[u] + weight < dist[v]) {
                     dist[v] = dist[u] + weight;
                     parent[v] = u;
@@ -50,7 +167,20 @@ public:
         return dist;
     }
     
+    // Dijkstra on a monotone priority queue (monotonequeue.h)
+    // Time: O(V pop + E push) in the queue's costs, Space: O(V)
+    // The queue is chosen at compile time: IndexedDaryHeap<4> in general,
+    // DialBuckets for small integer weights, RadixHeap for weights up to
+    // about 2^32. All three lower keys in place, so no vertex is popped
+    // twice and no stale entries pile up. Distances are 64-bit; unreachable
+    // vertices get LLONG_MAX.
+    template <typename Queue>
+    std::vector<long long> dijkstraWith(int start) {
+        return searchFrom<Queue>(adj.graph(), start);
+    }
+    
     std::vector<int> getPath(int start, int end) {
+        const CSRGraph& graph = adj.graph();
         std::vector<int> parent(V, -1);
         std::vector<int> dist(V, INT_MAX);
         
@@ -63,9 +193,16 @@ public:
         
         while (!pq.empty()) {
             int u = pq.top().second;
+            int d = pq.top().first;
             pq.pop();
             
-            for (auto& [v, weight] : adj[u]) {
+            if (d > dist[u]) continue;  // Stale entry
+            if (u == end) break;        // end is final once popped
+            
+            CSRGraph::Range<int> targets = graph.neighbors(u);
+            CSRGraph::Range<int> weights = graph.weightsOf(u);
+            for (int e = 0; e < targets.size(); e++) {
+                int v = targets[e], weight = weights[e];
                 if (dist[u] + weight < dist[v]) {
                     dist[v] = dist[u] + weight;
                     parent[v] = u;
@@ -85,11 +222,811 @@ public:
         
         return path;
     }
+    
+    // Delta-Stepping SSSP (Meyer, Sanders)
+    // Time: O(V + E + rounds * threads) work for suitable delta,
+    // Space: O(V + E)
+    // Tentative distances fall into buckets of width delta. Vertices in the
+    // lowest non-empty bucket are relaxed together, in parallel: light edges
+    // (weight <= delta) may land back in the same bucket, so that bucket is
+    // repeated until it stays empty, and heavy edges, which always land in a
+    // later bucket, are relaxed once at the end. Relaxations race only on the
+    // target's distance, settled by a CAS minimum; each thread queues the
+    // vertices it lowered and the queues are merged into the buckets.
+    // delta = 1 degenerates to Dial's algorithm, delta = infinity to
+    // Bellman-Ford. delta = 0 picks max weight / average degree, which keeps
+    // about one relaxation per edge on random weights while leaving buckets
+    // wide enough to share across threads. Buckets sit in a ring of
+    // maxWeight / delta + 2 slots (a relaxation from bucket c lands at most
+    // maxWeight / delta + 1 buckets ahead), so a tiny delta costs a large
+    // ring. The light/heavy split of the edges is an O(E) copy, cached
+    // until the next addEdge() or a call with a different delta.
+    // Distances are 64-bit; unreachable vertices get LLONG_MAX. Weights must
+    // be non-negative.
+    std::vector<long long> deltaStepping(int start, int threads = 0, long long delta = 0) {
+        const int PARALLEL_FRONTIER = 1024;  // Smaller rounds stay on one thread
+        if (threads <= 0) {
+            threads = std::max(1u, std::thread::hardware_concurrency());
+        }
+        
+        const CSRGraph& graph = adj.graph();
+        const std::vector<int>& offsets = graph.offsetArray();
+        if (steppingStale) {
+            stepping.maxWeight = 1;
+            for (int w : graph.weightArray()) stepping.maxWeight = std::max<long long>(stepping.maxWeight, w);
+            stepping.delta = 0;
+            steppingStale = false;
+        }
+        long long maxWeight = stepping.maxWeight;
+        if (delta <= 0) {
+            double averageDegree = std::max(1.0, (double)graph.edges() / std::max(1, V));
+            delta = std::max(1LL, (long long)(maxWeight / averageDegree));
+        }
+        
+        // Copy each vertex's edges with the light ones first, once per delta
+        if (stepping.delta != delta) {
+            stepping.delta = delta;
+            stepping.target.resize(graph.edges());
+            stepping.weight.resize(graph.edges());
+            stepping.lightEnd.resize(V);
+            runThreads(threads, [&](int t) {
+                for (int u = t; u < V; u += threads) {
+                    int slot = offsets[u];
+                    CSRGraph::Range<int> targets = graph.neighbors(u), weights = graph.weightsOf(u);
+                    for (int pass = 0; pass < 2; pass++) {
+                        for (int e = 0; e < targets.size(); e++) {
+                            if ((weights[e] > delta) == (pass == 1)) {
+                                stepping.target[slot] = targets[e];
+                                stepping.weight[slot++] = weights[e];
+                            }
+                        }
+                        if (pass == 0) stepping.lightEnd[u] = slot;
+                    }
+                }
+            });
+        }
+        const std::vector<int>& target = stepping.target;
+        const std::vector<int>& weight = stepping.weight;
+        const std::vector<int>& lightEnd = stepping.lightEnd;
+        
+        std::vector<std::atomic<long long>> dist(V);
+        for (int v = 0; v < V; v++) {
+            dist[v].store(LLONG_MAX, std::memory_order_relaxed);
+        }
+        dist[start].store(0, std::memory_order_relaxed);
+        
+        long long ringSize = maxWeight / delta + 2;
+        std::vector<std::vector<int>> ring(ringSize);
+        std::vector<long long> queuedIn(V, -1);  // Bucket holding v, -1 if none
+        std::vector<long long> settledIn(V, -1); // Last bucket that removed v
+        long long pending = 1;
+        ring[0].push_back(start);
+        queuedIn[start] = 0;
+        
+        std::vector<std::vector<int>> lowered(threads);
+        std::vector<int> frontier, removed;
+        
+        // Relax the light or heavy edges of every vertex in batch, in
+        // parallel, then file the lowered vertices into their buckets
+        auto relax = [&](const std::vector<int>& batch, bool light) {
+            int workers = std::min<long long>(threads, 1 + batch.size() / PARALLEL_FRONTIER);
+            runThreads(workers, [&](int t) {
+                std::vector<int>& mine = lowered[t];
+                size_t chunk = (batch.size() + workers - 1) / workers;
+                size_t from = std::min(batch.size(), t * chunk), to = std::min(batch.size(), from + chunk);
+                for (size_t i = from; i < to; i++) {
+                    int u = batch[i];
+                    long long du = dist[u].load(std::memory_order_relaxed);
+                    int first = light ? offsets[u] : lightEnd[u];
+                    int last = light ? lightEnd[u] : offsets[u + 1];
+                    for (int e = first; e < last; e++) {
+                        if (atomicRelax(dist[target[e]], du + weight[e])) {
+                            mine.push_back(target[e]);
+                        }
+                    }
+                }
+            });
+            for (int t = 0; t < workers; t++) {
+                for (int v : lowered[t]) {
+                    long long bucket = dist[v].load(std::memory_order_relaxed) / delta;
+                    if (queuedIn[v] == bucket) continue;
+                    queuedIn[v] = bucket;
+                    ring[bucket % ringSize].push_back(v);
+                    pending++;
+                }
+                lowered[t].clear();
+            }
+        };
+        
+        for (long long current = 0; pending > 0; current++) {
+            std::vector<int>& slot = ring[current % ringSize];
+            if (slot.empty()) continue;
+            
+            removed.clear();
+            while (!slot.empty()) {
+                // Entries that moved to a lower bucket since were filed again
+                frontier.clear();
+                for (int v : slot) {
+                    pending--;
+                    if (queuedIn[v] != current) continue;
+                    queuedIn[v] = -1;
+                    frontier.push_back(v);
+                    if (settledIn[v] != current) {
+                        settledIn[v] = current;
+                        removed.push_back(v);
+                    }
+                }
+                slot.clear();
+                relax(frontier, true);
+            }
+            relax(removed, false);
+        }
+        
+        std::vector<long long> result(V);
+        for (int v = 0; v < V; v++) {
+            result[v] = dist[v].load(std::memory_order_relaxed);
+        }
+        return result;
+    }
+    
+    // Bidirectional Dijkstra
+    // Time: O((V + E) log V) worst case, usually far less
+    // A forward search from start and a backward search into end over the
+    // reversed graph take turns; the side with the smaller radius goes next.
+    // mu is the shortest start-end path seen so far, updated whenever an
+    // edge joins a vertex labelled by one search to one labelled by the
+    // other. Once the two radii sum to at least mu, no unseen path can be
+    // shorter, so mu is the distance. Each search covers a ball of about half
+    // the radius, which on road-like graphs is a fraction of one full ball.
+    RouteResult bidirectionalDijkstra(int start, int end) {
+        const CSRGraph* side[2] = {&adj.graph(), &reverseGraph()};
+        std::vector<long long> dist[2] = {std::vector<long long>(V, LLONG_MAX),
+                                          std::vector<long long>(V, LLONG_MAX)};
+        std::vector<int> parent[2] = {std::vector<int>(V, -1), std::vector<int>(V, -1)};
+        IndexedDaryHeap<4> queue[2] = {IndexedDaryHeap<4>(V), IndexedDaryHeap<4>(V)};
+        long long radius[2] = {0, 0};
+        
+        dist[0][start] = 0;
+        dist[1][end] = 0;
+        queue[0].push(start, 0);
+        queue[1].push(end, 0);
+        long long mu = start == end ? 0 : LLONG_MAX;
+        int meet = start == end ? start : -1;
+        int settled = 0;
+        
+        while (!queue[0].empty() && !queue[1].empty()) {
+            int dir = radius[0] <= radius[1] ? 0 : 1;
+            auto [d, u] = queue[dir].pop();
+            radius[dir] = d;
+            if (mu != LLONG_MAX && radius[0] + radius[1] >= mu) break;
+            settled++;
+            
+            const std::vector<long long>& other = dist[1 - dir];
+            CSRGraph::Range<int> targets = side[dir]->neighbors(u);
+            CSRGraph::Range<int> weights = side[dir]->weightsOf(u);
+            for (int e = 0; e < targets.size(); e++) {
+                int v = targets[e];
+                long long candidate = d + weights[e];
+                if (candidate < dist[dir][v]) {
+                    dist[dir][v] = candidate;
+                    parent[dir][v] = u;
+                    queue[dir].push(v, candidate);
+                }
+                if (other[v] != LLONG_MAX && candidate + other[v] < mu) {
+                    mu = candidate + other[v];
+                    meet = v;
+                }
+            }
+        }
+        
+        // start -> meet on forward parents, then meet -> end on backward ones
+        RouteResult result{mu, {}, settled};
+        if (meet == -1) return result;
+        result.path = tracePath(parent[0], meet);
+        for (int v = parent[1][meet]; v != -1; v = parent[1][v]) {
+            result.path.push_back(v);
+        }
+        return result;
+    }
+    
+    // A* search
+    // Time: O((V + E) log V) worst case
+    // Pops vertices by g(v) + h(v), where g is the distance from start and
+    // h(v) a lower bound on the distance from v to end. With h = 0 this is
+    // Dijkstra; the tighter h, the fewer vertices lie below the goal's key.
+    // h must be admissible (never overestimate) for an exact answer. A
+    // consistent h (h(u) <= w(u, v) + h(v)) also settles every vertex once;
+    // an admissible but inconsistent one can reopen vertices, which push()
+    // handles by queueing them again.
+    template <typename Heuristic>
+    RouteResult aStar(int start, int end, Heuristic h) {
+        const CSRGraph& graph = adj.graph();
+        std::vector<long long> dist(V, LLONG_MAX);
+        std::vector<int> parent(V, -1);
+        IndexedDaryHeap<4> queue(V);
+        int settled = 0;
+        
+        dist[start] = 0;
+        queue.push(start, h(start));
+        
+        while (!queue.empty()) {
+            int u = queue.pop().second;
+            settled++;
+            if (u == end) break;
+            
+            CSRGraph::Range<int> targets = graph.neighbors(u);
+            CSRGraph::Range<int> weights = graph.weightsOf(u);
+            for (int e = 0; e < targets.size(); e++) {
+                int v = targets[e];
+                long long candidate = dist[u] + weights[e];
+                if (candidate < dist[v]) {
+                    long long bound = h(v);
+                    if (bound == LLONG_MAX) continue;  // end unreachable from v
+                    dist[v] = candidate;
+                    parent[v] = u;
+                    queue.push(v, candidate + bound);
+                }
+            }
+        }
+        
+        RouteResult result{dist[end], {}, settled};
+        if (dist[end] != LLONG_MAX) result.path = tracePath(parent, end);
+        return result;
+    }
+    
+    // ALT preprocessing (A*, Landmarks, Triangle inequality; Goldberg, Harrelson)
+    // Time: O(count * (V + E) log V), Space: O(count * V)
+    // Picks landmarks by farthest-point selection (each new one is the vertex
+    // farthest from those already chosen) and stores exact distances from and
+    // to each. Landmarks on the fringe of the graph lie behind many targets,
+    // which makes the bounds below tight.
+    void preprocessLandmarks(int count) {
+        const CSRGraph& forward = adj.graph();
+        const CSRGraph& backward = reverseGraph();
+        landmarks.clear();
+        fromLandmark.clear();
+        toLandmark.clear();
+        if (V == 0) return;
+        
+        std::vector<long long> nearest(V, LLONG_MAX);  // Distance to the closest landmark
+        int next = 0;
+        for (int i = 0; i < count && next != -1; i++) {
+            landmarks.push_back(next);
+            fromLandmark.push_back(searchFrom<IndexedDaryHeap<4>>(forward, next));
+            toLandmark.push_back(searchFrom<IndexedDaryHeap<4>>(backward, next));
+            
+            next = -1;
+            long long farthest = 0;
+            for (int v = 0; v < V; v++) {
+                nearest[v] = std::min(nearest[v], fromLandmark.back()[v]);
+                if (nearest[v] != LLONG_MAX && nearest[v] > farthest) {
+                    farthest = nearest[v];
+                    next = v;
+                }
+            }
+        }
+    }
+    
+    // A* with the landmark bound: by the triangle inequality, for every
+    // landmark L both d(L, end) - d(L, v) and d(v, L) - d(end, L) are lower
+    // bounds on d(v, end), and so is their maximum. The bound is consistent.
+    // Without preprocessLandmarks() it degrades to Dijkstra with early exit.
+    RouteResult altQuery(int start, int end) {
+        auto bound = [&](int v) {
+            long long best = 0;
+            for (size_t i = 0; i < landmarks.size(); i++) {
+                long long lv = fromLandmark[i][v], lt = fromLandmark[i][end];
+                long long vl = toLandmark[i][v], tl = toLandmark[i][end];
+                if (lt != LLONG_MAX && lv != LLONG_MAX) best = std::max(best, lt - lv);
+                if (vl != LLONG_MAX && tl != LLONG_MAX) best = std::max(best, vl - tl);
+                // L reaches v but not end, so v cannot reach end either
+                if (lv != LLONG_MAX && lt == LLONG_MAX) return LLONG_MAX;
+            }
+            return best;
+        };
+        return aStar(start, end, bound);
+    }
+};
+
+// Contraction Hierarchies (Geisberger, Sanders, Schultes, Delling)
+// Preprocessing removes ("contracts") vertices one at a time in order of
+// importance. Contracting v adds a shortcut u -> w of weight
+// d(u, v) + d(v, w) for each in-neighbour u and out-neighbour w still
+// present, unless a witness search finds a path from u to w that avoids v
+// and is no longer. Shortest distances among the remaining vertices never
+// change, so every shortest path can be rewritten as edges that first go
+// up in rank and then come down. A query therefore runs Dijkstra forward
+// from s and backward from t on upward edges only, and each side settles a
+// few hundred vertices even on country-sized road graphs.
+//   - Order: by twice the edge difference (shortcuts added minus edges
+//     removed) plus the number of already contracted neighbours, which
+//     spreads contractions evenly. Priorities are refreshed for a vertex's
+//     neighbours after it is contracted and lazily when it is popped.
+//   - Witness searches stop once all targets are settled or a settle limit
+//     is hit; a search cut short only costs a superfluous shortcut, never a
+//     wrong answer.
+//   - Each shortcut keeps its middle vertex, so paths unpack recursively.
+// Queries reuse scratch arrays (cleared through touched lists), so one
+// hierarchy answers queries from one thread at a time.
+class ContractionHierarchy {
+private:
+    // Settle limits for witness searches: tight while only estimating a
+    // priority, looser when the shortcuts are really added
+    static const int SIMULATE_SETTLE_LIMIT = 50;
+    static const int CONTRACT_SETTLE_LIMIT = 500;
+    
+    // Edges to higher-ranked vertices, with 64-bit weights and the middle
+    // vertex of a shortcut (-1 for an original edge)
+    struct UpwardEdges {
+        std::vector<int> offsets{0};
+        std::vector<int> targets;
+        std::vector<long long> weights;
+        std::vector<int> middles;
+    };
+    
+    struct Arc {
+        int to;
+        long long weight;
+        int middle;
+    };
+    
+    int V = 0;
+    std::vector<int> rank;
+    UpwardEdges up[2];  // [0]: u -> w with rank w > rank u; [1]: w -> u stored at u
+    
+    // Query scratch
+    std::vector<long long> dist[2];
+    std::vector<int> parentEdge[2];  // Edge index in up[dir] that reached v
+    std::vector<int> parentVertex[2];
+    std::vector<int> touched[2];
+    IndexedDaryHeap<4> queue[2] = {IndexedDaryHeap<4>(0), IndexedDaryHeap<4>(0)};
+    
+    ContractionHierarchy() = default;
+    
+    void prepareScratch() {
+        for (int dir = 0; dir < 2; dir++) {
+            dist[dir].assign(V, LLONG_MAX);
+            parentEdge[dir].assign(V, -1);
+            parentVertex[dir].assign(V, -1);
+            queue[dir] = IndexedDaryHeap<4>(V);
+        }
+    }
+    
+    // Lower the arc to `to` in list, or add it
+    static void mergeArc(std::vector<Arc>& list, int to, long long weight, int middle) {
+        for (Arc& arc : list) {
+            if (arc.to == to) {
+                if (weight < arc.weight) {
+                    arc.weight = weight;
+                    arc.middle = middle;
+                }
+                return;
+            }
+        }
+        list.push_back({to, weight, middle});
+    }
+    
+    static void removeArc(std::vector<Arc>& list, int to) {
+        for (size_t i = 0; i < list.size(); i++) {
+            if (list[i].to == to) {
+                list[i] = list.back();
+                list.pop_back();
+                return;
+            }
+        }
+    }
+    
+    // Scratch for witness searches, reset through the labelled list
+    struct WitnessSearch {
+        std::vector<long long> dist;
+        std::vector<int> labelled;
+        std::vector<char> isTarget;
+        std::vector<std::pair<long long, int>> heap;
+        
+        explicit WitnessSearch(int n) : dist(n, LLONG_MAX), isTarget(n, 0) {}
+    };
+    
+    // Forward Dijkstra from u over uncontracted vertices, never entering
+    // skip. Stops once every target is settled, past maxDistance, or after
+    // settleLimit vertices; search.dist[w] is then an upper bound on the
+    // best witness to w (LLONG_MAX if none found).
+    static void witnessSearch(const std::vector<std::vector<Arc>>& out,
+                              const std::vector<char>& contracted,
+                              int u, int skip, long long maxDistance, int targets,
+                              int settleLimit, WitnessSearch& search) {
+        auto later = std::greater<std::pair<long long, int>>();
+        std::vector<std::pair<long long, int>>& heap = search.heap;
+        heap.clear();
+        search.dist[u] = 0;
+        search.labelled.push_back(u);
+        heap.push_back({0, u});
+        int settled = 0;
+        
+        while (!heap.empty() && settled < settleLimit && targets > 0) {
+            std::pop_heap(heap.begin(), heap.end(), later);
+            auto [d, x] = heap.back();
+            heap.pop_back();
+            if (d > search.dist[x]) continue;
+            if (d > maxDistance) break;
+            settled++;
+            if (search.isTarget[x]) targets--;
+            
+            for (const Arc& arc : out[x]) {
+                if (arc.to == skip || contracted[arc.to]) continue;
+                long long candidate = d + arc.weight;
+                if (candidate < search.dist[arc.to]) {
+                    if (search.dist[arc.to] == LLONG_MAX) search.labelled.push_back(arc.to);
+                    search.dist[arc.to] = candidate;
+                    heap.push_back({candidate, arc.to});
+                    std::push_heap(heap.begin(), heap.end(), later);
+                }
+            }
+        }
+    }
+    
+    // Shortcuts needed to contract v: {{u, w}, weight}
+    static std::vector<std::pair<std::pair<int, int>, long long>>
+    shortcutsFor(int v, const std::vector<std::vector<Arc>>& out,
+                 const std::vector<std::vector<Arc>>& in,
+                 const std::vector<char>& contracted, int settleLimit,
+                 WitnessSearch& search) {
+        std::vector<std::pair<std::pair<int, int>, long long>> shortcuts;
+        long long maxOut = 0;
+        for (const Arc& arc : out[v]) {
+            maxOut = std::max(maxOut, arc.weight);
+            search.isTarget[arc.to] = 1;
+        }
+        
+        for (const Arc& incoming : in[v]) {
+            int u = incoming.to;
+            witnessSearch(out, contracted, u, v, incoming.weight + maxOut, out[v].size(),
+                          settleLimit, search);
+            for (const Arc& outgoing : out[v]) {
+                int w = outgoing.to;
+                if (w == u) continue;
+                long long via = incoming.weight + outgoing.weight;
+                if (search.dist[w] > via) {
+                    shortcuts.push_back({{u, w}, via});
+                }
+            }
+            for (int x : search.labelled) search.dist[x] = LLONG_MAX;
+            search.labelled.clear();
+        }
+        
+        for (const Arc& arc : out[v]) search.isTarget[arc.to] = 0;
+        return shortcuts;
+    }
+    
+    static void appendEdges(UpwardEdges& edges, const std::vector<Arc>& arcs) {
+        for (const Arc& arc : arcs) {
+            edges.targets.push_back(arc.to);
+            edges.weights.push_back(arc.weight);
+            edges.middles.push_back(arc.middle);
+        }
+        edges.offsets.push_back(edges.targets.size());
+    }
+    
+    // Edge index of a -> b: stored at a in up[0] or at b in up[1]
+    int findEdge(int dir, int at, int other) const {
+        const UpwardEdges& edges = up[dir];
+        for (int e = edges.offsets[at]; e < edges.offsets[at + 1]; e++) {
+            if (edges.targets[e] == other) return e;
+        }
+        return -1;
+    }
+    
+    // Append the vertices after a on the original path a -> b
+    void unpack(int a, int b, int middle, std::vector<int>& path) const {
+        if (middle == -1) {
+            path.push_back(b);
+            return;
+        }
+        // middle was contracted before a and b, so it holds both halves
+        int first = findEdge(1, middle, a);
+        int second = findEdge(0, middle, b);
+        unpack(a, middle, up[1].middles[first], path);
+        unpack(middle, b, up[0].middles[second], path);
+    }
+    
+    static void writeVector(std::ofstream& file, const std::vector<int>& data) {
+        long long size = data.size();
+        file.write(reinterpret_cast<const char*>(&size), sizeof(size));
+        file.write(reinterpret_cast<const char*>(data.data()), size * sizeof(int));
+    }
+    
+    static void writeVector(std::ofstream& file, const std::vector<long long>& data) {
+        long long size = data.size();
+        file.write(reinterpret_cast<const char*>(&size), sizeof(size));
+        file.write(reinterpret_cast<const char*>(data.data()), size * sizeof(long long));
+    }
+    
+    template <typename T>
+    static void readVector(std::ifstream& file, std::vector<T>& data) {
+        long long size = 0;
+        file.read(reinterpret_cast<char*>(&size), sizeof(size));
+        if (!file || size < 0) throw std::runtime_error("truncated hierarchy file");
+        // A damaged length must not turn into a huge allocation: the
+        // elements have to be in the file
+        std::streampos here = file.tellg();
+        file.seekg(0, std::ios::end);
+        long long remaining = file.tellg() - here;
+        file.seekg(here);
+        if (size > remaining / (long long)sizeof(T)) throw std::runtime_error("truncated hierarchy file");
+        data.resize(size);
+        file.read(reinterpret_cast<char*>(data.data()), size * sizeof(T));
+        if (!file) throw std::runtime_error("truncated hierarchy file");
+    }
+
+public:
+    // Preprocessing
+    // Time: roughly O(V * witness search) on road-like graphs; dense graphs
+    // can need many shortcuts. Space: O(V + E + shortcuts)
+    explicit ContractionHierarchy(Graph& graph) : V(graph.vertices()) {
+        const CSRGraph& csr = graph.csr();
+        std::vector<std::vector<Arc>> out(V), in(V);
+        for (int u = 0; u < V; u++) {
+            CSRGraph::Range<int> targets = csr.neighbors(u);
+            CSRGraph::Range<int> weights = csr.weightsOf(u);
+            for (int e = 0; e < targets.size(); e++) {
+                if (targets[e] == u) continue;  // Self-loops never shorten a path
+                mergeArc(out[u], targets[e], weights[e], -1);
+                mergeArc(in[targets[e]], u, weights[e], -1);
+            }
+        }
+        
+        std::vector<char> contracted(V, 0);
+        std::vector<int> deletedNeighbours(V, 0), priority(V);
+        WitnessSearch search(V);
+        
+        auto computePriority = [&](int v) {
+            int added = shortcutsFor(v, out, in, contracted, SIMULATE_SETTLE_LIMIT, search).size();
+            int removed = out[v].size() + in[v].size();
+            return 2 * (added - removed) + deletedNeighbours[v];
+        };
+        
+        std::priority_queue<std::pair<int, int>,
+                            std::vector<std::pair<int, int>>,
+                            std::greater<std::pair<int, int>>> order;
+        for (int v = 0; v < V; v++) {
+            priority[v] = computePriority(v);
+            order.push({priority[v], v});
+        }
+        
+        rank.assign(V, -1);
+        int contractedCount = 0;
+        std::vector<std::vector<Arc>> upwardOut(V), upwardIn(V);
+        while (!order.empty()) {
+            auto [p, v] = order.top();
+            order.pop();
+            if (contracted[v] || p != priority[v]) continue;
+            
+            // Lazy update: contract only if still no worse than the next one
+            priority[v] = computePriority(v);
+            if (!order.empty() && priority[v] > order.top().first) {
+                order.push({priority[v], v});
+                continue;
+            }
+            
+            for (auto& [pair, weight] : shortcutsFor(v, out, in, contracted, CONTRACT_SETTLE_LIMIT, search)) {
+                mergeArc(out[pair.first], pair.second, weight, v);
+                mergeArc(in[pair.second], pair.first, weight, v);
+            }
+            
+            rank[v] = contractedCount++;
+            contracted[v] = 1;
+            std::vector<int> neighbours;
+            for (const Arc& arc : out[v]) {
+                removeArc(in[arc.to], v);
+                neighbours.push_back(arc.to);
+            }
+            for (const Arc& arc : in[v]) {
+                removeArc(out[arc.to], v);
+                neighbours.push_back(arc.to);
+            }
+            
+            // Every arc v still has leads to a vertex contracted later
+            upwardOut[v] = std::move(out[v]);
+            upwardIn[v] = std::move(in[v]);
+            out[v].clear();
+            in[v].clear();
+            
+            std::sort(neighbours.begin(), neighbours.end());
+            neighbours.erase(std::unique(neighbours.begin(), neighbours.end()), neighbours.end());
+            for (int x : neighbours) {
+                deletedNeighbours[x]++;
+                priority[x] = computePriority(x);
+                order.push({priority[x], x});
+            }
+        }
+        
+        for (int v = 0; v < V; v++) {
+            appendEdges(up[0], upwardOut[v]);
+            appendEdges(up[1], upwardIn[v]);
+        }
+        prepareScratch();
+    }
+    
+    int vertices() const { return V; }
+    
+    int shortcuts() const {
+        int count = 0;
+        for (int dir = 0; dir < 2; dir++) {
+            for (int middle : up[dir].middles) count += middle != -1;
+        }
+        return count;
+    }
+    
+    // Bidirectional upward query
+    // Both searches only climb in rank. A side stops once its smallest key
+    // reaches the best s-t distance met so far, since every later meeting
+    // through it would be longer.
+    RouteResult query(int s, int t) {
+        for (int dir = 0; dir < 2; dir++) {
+            for (int v : touched[dir]) {
+                dist[dir][v] = LLONG_MAX;
+                parentEdge[dir][v] = -1;
+                parentVertex[dir][v] = -1;
+            }
+            touched[dir].clear();
+            queue[dir].clear();
+        }
+        
+        int source[2] = {s, t};
+        for (int dir = 0; dir < 2; dir++) {
+            dist[dir][source[dir]] = 0;
+            touched[dir].push_back(source[dir]);
+            queue[dir].push(source[dir], 0);
+        }
+        
+        long long best = LLONG_MAX;
+        int meet = -1, settled = 0;
+        while (!queue[0].empty() || !queue[1].empty()) {
+            for (int dir = 0; dir < 2; dir++) {
+                if (queue[dir].empty()) continue;
+                auto [d, u] = queue[dir].pop();
+                if (d >= best) {
+                    queue[dir].clear();
+                    continue;
+                }
+                settled++;
+                if (dist[1 - dir][u] != LLONG_MAX && d + dist[1 - dir][u] < best) {
+                    best = d + dist[1 - dir][u];
+                    meet = u;
+                }
+                
+                const UpwardEdges& edges = up[dir];
+                for (int e = edges.offsets[u]; e < edges.offsets[u + 1]; e++) {
+                    int v = edges.targets[e];
+                    long long candidate = d + edges.weights[e];
+                    if (candidate < dist[dir][v]) {
+                        if (dist[dir][v] == LLONG_MAX) touched[dir].push_back(v);
+                        dist[dir][v] = candidate;
+                        parentEdge[dir][v] = e;
+                        parentVertex[dir][v] = u;
+                        queue[dir].push(v, candidate);
+                    }
+                }
+            }
+        }
+        
+        RouteResult result{best, {}, settled};
+        if (meet == -1) return result;
+        
+        // s up to meet: collect hierarchy edges, then unpack in order
+        std::vector<int> climb;
+        for (int x = meet; x != s; x = parentVertex[0][x]) {
+            climb.push_back(x);
+        }
+        result.path.push_back(s);
+        for (int i = climb.size() - 1; i >= 0; i--) {
+            int x = climb[i];
+            unpack(parentVertex[0][x], x, up[0].middles[parentEdge[0][x]], result.path);
+        }
+        // meet down to t
+        for (int x = meet; x != t; x = parentVertex[1][x]) {
+            unpack(x, parentVertex[1][x], up[1].middles[parentEdge[1][x]], result.path);
+        }
+        return result;
+    }
+    
+    long long distance(int s, int t) {
+        return query(s, t).distance;
+    }
+    
+    // Hierarchy file: "CH01", V, then rank and both upward edge arrays, each
+    // as a 64-bit length followed by raw elements (native byte order)
+    void save(const std::string& path) const {
+        std::ofstream file(path, std::ios::binary);
+        if (!file) throw std::runtime_error("cannot open " + path);
+        file.write("CH01", 4);
+        file.write(reinterpret_cast<const char*>(&V), sizeof(V));
+        writeVector(file, rank);
+        for (int dir = 0; dir < 2; dir++) {
+            writeVector(file, up[dir].offsets);
+            writeVector(file, up[dir].targets);
+            writeVector(file, up[dir].weights);
+            writeVector(file, up[dir].middles);
+        }
+        if (!file) throw std::runtime_error("cannot write " + path);
+    }
+    
+    static ContractionHierarchy load(const std::string& path) {
+        std::ifstream file(path, std::ios::binary);
+        if (!file) throw std::runtime_error("cannot open " + path);
+        char magic[4];
+        file.read(magic, 4);
+        if (!file || std::string(magic, 4) != "CH01") {
+            throw std::runtime_error(path + " is not a hierarchy file");
+        }
+        
+        ContractionHierarchy hierarchy;
+        file.read(reinterpret_cast<char*>(&hierarchy.V), sizeof(hierarchy.V));
+        if (!file || hierarchy.V < 0) throw std::runtime_error(path + " is corrupt");
+        int V = hierarchy.V;
+        readVector(file, hierarchy.rank);
+        if ((int)hierarchy.rank.size() != V) throw std::runtime_error(path + " is corrupt");
+        for (int r : hierarchy.rank) {
+            if (r < 0 || r >= V) throw std::runtime_error(path + " is corrupt");
+        }
+        
+        // Queries index straight into these arrays, so every offset and
+        // vertex id is checked before the hierarchy is used
+        for (int dir = 0; dir < 2; dir++) {
+            UpwardEdges& edges = hierarchy.up[dir];
+            readVector(file, edges.offsets);
+            readVector(file, edges.targets);
+            readVector(file, edges.weights);
+            readVector(file, edges.middles);
+            if ((int)edges.offsets.size() != V + 1 || edges.offsets[0] != 0) {
+                throw std::runtime_error(path + " is corrupt");
+            }
+            for (int u = 0; u < V; u++) {
+                if (edges.offsets[u] > edges.offsets[u + 1]) {
+                    throw std::runtime_error(path + " is corrupt");
+                }
+            }
+            size_t count = edges.offsets[V];
+            if (edges.targets.size() != count || edges.weights.size() != count ||
+                edges.middles.size() != count) {
+                throw std::runtime_error(path + " is corrupt");
+            }
+            for (size_t e = 0; e < count; e++) {
+                if (edges.targets[e] < 0 || edges.targets[e] >= V || edges.weights[e] < 0 ||
+                    edges.middles[e] < -1 || edges.middles[e] >= V) {
+                    throw std::runtime_error(path + " is corrupt");
+                }
+            }
+        }
+        
+        // Edges climb in rank, and a shortcut's middle ranks below both ends
+        // and holds both halves; unpacking recurses on exactly those, so this
+        // also keeps it finite
+        const std::vector<int>& rank = hierarchy.rank;
+        for (int dir = 0; dir < 2; dir++) {
+            const UpwardEdges& edges = hierarchy.up[dir];
+            for (int u = 0; u < V; u++) {
+                for (int e = edges.offsets[u]; e < edges.offsets[u + 1]; e++) {
+                    int v = edges.targets[e];
+                    int middle = edges.middles[e];
+                    if (rank[v] <= rank[u]) throw std::runtime_error(path + " is corrupt");
+                    if (middle == -1) continue;
+                    int a = dir == 0 ? u : v;  // Shortcut a -> b
+                    int b = dir == 0 ? v : u;
+                    if (rank[middle] >= rank[u] || hierarchy.findEdge(1, middle, a) == -1 ||
+                        hierarchy.findEdge(0, middle, b) == -1) {
+                        throw std::runtime_error(path + " is corrupt");
+                    }
+                }
+            }
+        }
+        hierarchy.prepareScratch();
+        return hierarchy;
+    }
 };
 
 int main() {
-    std::cout << \"=== Dijkstra's Algorithm ===\" << std::endl;
-    std::cout << \"Time: O((V+E) log V), Space: O(V)\" << std::endl << std::endl;
+    std::cout << "=== Dijkstra's Algorithm ===" << std::endl;
+    std::cout << "Time: O((V+E) log V), Space: O(V)" << std::endl << std::endl;
     
     Graph g(6);
     g.addEdge(0, 1, 4);
@@ -104,15 +1041,129 @@ int main() {
     
     std::vector<int> distances = g.dijkstra(0);
     
-    std::cout << \"Shortest distances from vertex 0:\" << std::endl;
+    std::cout << "Shortest distances from vertex 0:" << std::endl;
     for (int i = 0; i < distances.size(); i++) {
-        std::cout << \"  To \" << i << \": \" << distances[i] << std::endl;
+        std::cout << "  To " << i << ": " << distances[i] << std::endl;
     }
     
-    std::cout << \"\\nShortest path from 0 to 5: \";
+    std::cout << "\nShortest path from 0 to 5: ";
     std::vector<int> path = g.getPath(0, 5);
-    for (int v : path) std::cout << v << \" \";
+    for (int v : path) std::cout << v << " ";
     std::cout << std::endl;
     
+    std::cout << "\n=== Delta-Stepping ===" << std::endl;
+    std::vector<long long> stepped = g.deltaStepping(0);
+    std::cout << "Distances from vertex 0: ";
+    for (long long d : stepped) std::cout << d << " ";
+    std::cout << std::endl;
+    
+    // Path lengths past INT_MAX need the 64-bit distances
+    Graph chain(4);
+    chain.addEdge(0, 1, 2000000000);
+    chain.addEdge(1, 2, 2000000000);
+    chain.addEdge(2, 3, 2000000000);
+    std::cout << "Chain of three 2e9 edges, distance 0 -> 3: "
+              << chain.deltaStepping(0)[3] << std::endl;
+    
+    // Weighted grid, the shape of a road network
+    int side = 512;
+    Graph grid(side * side);
+    uint32_t state = 99;
+    for (int y = 0; y < side; y++) {
+        for (int x = 0; x < side; x++) {
+            int u = y * side + x;
+            state = state * 1103515245 + 12345;
+            int right = 1 + (state >> 16) % 1000;
+            state = state * 1103515245 + 12345;
+            int down = 1 + (state >> 16) % 1000;
+            if (x + 1 < side) {
+                grid.addEdge(u, u + 1, right);
+                grid.addEdge(u + 1, u, right);
+            }
+            if (y + 1 < side) {
+                grid.addEdge(u, u + side, down);
+                grid.addEdge(u + side, u, down);
+            }
+        }
+    }
+    std::vector<int> heapDist = grid.dijkstra(0);
+    std::vector<long long> bucketDist = grid.deltaStepping(0);
+    bool same = true;
+    for (int v = 0; v < side * side; v++) {
+        same &= heapDist[v] == bucketDist[v];
+    }
+    std::cout << "512x512 grid, distance to far corner: " << bucketDist.back() << std::endl;
+    std::cout << "Matches binary-heap Dijkstra: " << (same ? "Yes" : "No") << std::endl;
+    
+    std::cout << "\n=== Monotone Priority Queues ===" << std::endl;
+    bool queuesAgree = grid.dijkstraWith<IndexedDaryHeap<4>>(0) == bucketDist &&
+                       grid.dijkstraWith<DialBuckets>(0) == bucketDist &&
+                       grid.dijkstraWith<RadixHeap>(0) == bucketDist;
+    std::cout << "4-ary heap, Dial buckets and radix heap agree: "
+              << (queuesAgree ? "Yes" : "No") << std::endl;
+    
+    // Point-to-point queries across a quarter of the grid
+    std::cout << "\n=== Point-to-Point Queries ===" << std::endl;
+    int from = side * (side / 4) + side / 4, to = side * (side / 2) + side / 2;
+    auto report = [](const char* name, const RouteResult& route) {
+        std::cout << name << route.distance << ", path " << route.path.size()
+                  << " vertices, settled " << route.settled << std::endl;
+    };
+    
+    RouteResult plain = grid.aStar(from, to, [](int) { return 0LL; });
+    report("Dijkstra (early exit): ", plain);
+    report("Bidirectional:         ", grid.bidirectionalDijkstra(from, to));
+    
+    // Manhattan distance times the smallest weight (1) never overestimates;
+    // with weights up to 1000 it is loose, which is what landmarks fix
+    auto manhattan = [side, to](int v) {
+        return (long long)(std::abs(v / side - to / side) + std::abs(v % side - to % side));
+    };
+    report("A* (Manhattan):        ", grid.aStar(from, to, manhattan));
+    
+    grid.preprocessLandmarks(8);
+    report("ALT (8 landmarks):     ", grid.altQuery(from, to));
+    
+    // A short hop touches only its neighbourhood
+    int mid = side * (side / 2) + side / 2;
+    report("ALT, short hop:        ", grid.altQuery(mid, mid + 3 * side + 4));
+    
+    // Grids are a hard case for contraction (no small separators), so the
+    // demo uses a smaller one; road networks contract far better
+    std::cout << "\n=== Contraction Hierarchies ===" << std::endl;
+    int chSide = 128;
+    Graph roads(chSide * chSide);
+    for (int y = 0; y < chSide; y++) {
+        for (int x = 0; x < chSide; x++) {
+            int u = y * chSide + x;
+            state = state * 1103515245 + 12345;
+            int right = 1 + (state >> 16) % 1000;
+            state = state * 1103515245 + 12345;
+            int down = 1 + (state >> 16) % 1000;
+            if (x + 1 < chSide) {
+                roads.addEdge(u, u + 1, right);
+                roads.addEdge(u + 1, u, right);
+            }
+            if (y + 1 < chSide) {
+                roads.addEdge(u, u + chSide, down);
+                roads.addEdge(u + chSide, u, down);
+            }
+        }
+    }
+    ContractionHierarchy hierarchy(roads);
+    std::cout << "128x128 grid contracted with " << hierarchy.shortcuts() << " shortcuts" << std::endl;
+    
+    std::string file = (std::filesystem::temp_directory_path() / "dijkstra_demo.ch").string();
+    hierarchy.save(file);
+    ContractionHierarchy loaded = ContractionHierarchy::load(file);
+    std::filesystem::remove(file);
+    
+    int chFrom = 0, chTo = chSide * chSide - 1;
+    report("Dijkstra (early exit): ", roads.aStar(chFrom, chTo, [](int) { return 0LL; }));
+    report("CH query:              ", hierarchy.query(chFrom, chTo));
+    std::cout << "Reloaded hierarchy agrees: "
+              << (loaded.distance(chFrom, chTo) == hierarchy.distance(chFrom, chTo) ? "Yes" : "No")
+              << std::endl;
+    
     return 0;
 }
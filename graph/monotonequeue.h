@@ -0,0 +1,238 @@
+#ifndef MONOTONEQUEUE_H
+#define MONOTONEQUEUE_H
+
+#include <vector>
+#include <utility>
+#include <algorithm>
+
+// Monotone Priority Queues for Dijkstra-style searches
+// Items are vertex ids 0..n-1 with 64-bit keys. Every queue is indexed: a
+// vertex is queued at most once and push() lowers the key of a queued
+// vertex in place, so nothing goes stale and the queue never holds more
+// than n entries (a lazy-deletion binary heap can reach O(E)).
+// Shared interface, selected by a template parameter:
+//   Queue(int n, long long maxWeight)   maxWeight bounds any one edge weight
+//   bool empty() const
+//   void push(int v, long long key)     insert, or lower v's key; a key that
+//                                       is not lower is ignored
+//   std::pair<long long, int> pop()     {key, vertex} with the minimum key
+// DialBuckets and RadixHeap also need monotone keys: nothing pushed may be
+// below the last popped key, which holds for non-negative edge weights.
+
+// Intrusive doubly-linked lists of vertices, one per bucket
+class BucketLists {
+private:
+    std::vector<int> head, next, prev, bucketOf;
+
+public:
+    BucketLists(int buckets, int n)
+        : head(buckets, -1), next(n), prev(n), bucketOf(n, -1) {}
+    
+    bool empty(int bucket) const { return head[bucket] == -1; }
+    int first(int bucket) const { return head[bucket]; }
+    int after(int v) const { return next[v]; }
+    bool queued(int v) const { return bucketOf[v] != -1; }
+    
+    void link(int v, int bucket) {
+        bucketOf[v] = bucket;
+        prev[v] = -1;
+        next[v] = head[bucket];
+        if (head[bucket] != -1) prev[head[bucket]] = v;
+        head[bucket] = v;
+    }
+    
+    void unlink(int v) {
+        if (prev[v] != -1) {
+            next[prev[v]] = next[v];
+        } else {
+            head[bucketOf[v]] = next[v];
+        }
+        if (next[v] != -1) prev[next[v]] = prev[v];
+        bucketOf[v] = -1;
+    }
+};
+
+// d-ary indexed heap with decrease-key
+// Push: O(log_d n), Pop: O(d log_d n)
+// A 4-ary heap is half as deep as a binary one and the four children of a
+// node share a cache line, which usually outweighs the extra compares.
+template <int D = 4>
+class IndexedDaryHeap {
+private:
+    std::vector<int> heap;
+    std::vector<int> position;  // Index in heap, -1 if not queued
+    std::vector<long long> keyOf;
+    
+    void place(int index, int v) {
+        heap[index] = v;
+        position[v] = index;
+    }
+    
+    void siftUp(int index) {
+        int v = heap[index];
+        while (index > 0) {
+            int parent = (index - 1) / D;
+            if (keyOf[heap[parent]] <= keyOf[v]) break;
+            place(index, heap[parent]);
+            index = parent;
+        }
+        place(index, v);
+    }
+    
+    void siftDown(int index) {
+        int v = heap[index];
+        int size = heap.size();
+        while (true) {
+            int child = D * index + 1;
+            if (child >= size) break;
+            int best = child;
+            int last = std::min(child + D, size);
+            for (int c = child + 1; c < last; c++) {
+                if (keyOf[heap[c]] < keyOf[heap[best]]) best = c;
+            }
+            if (keyOf[heap[best]] >= keyOf[v]) break;
+            place(index, heap[best]);
+            index = best;
+        }
+        place(index, v);
+    }
+
+public:
+    IndexedDaryHeap(int n, long long = 0) : position(n, -1), keyOf(n) {}
+    
+    bool empty() const { return heap.empty(); }
+    
+    // O(size), not O(n): reusable across many short searches
+    void clear() {
+        for (int v : heap) {
+            position[v] = -1;
+        }
+        heap.clear();
+    }
+    
+    void push(int v, long long key) {
+        if (position[v] == -1) {
+            position[v] = heap.size();
+            heap.push_back(v);
+        } else if (key >= keyOf[v]) {
+            return;
+        }
+        keyOf[v] = key;
+        siftUp(position[v]);
+    }
+    
+    std::pair<long long, int> pop() {
+        int top = heap[0];
+        int last = heap.back();
+        heap.pop_back();
+        if (!heap.empty()) {
+            place(0, last);
+            siftDown(0);
+        }
+        position[top] = -1;
+        return {keyOf[top], top};
+    }
+};
+
+// Dial's circular buckets
+// Push: O(1), Pop: O(1) amortized plus the empty buckets skipped
+// Queued keys always lie in [last popped, last popped + maxWeight], so a
+// ring of maxWeight + 1 buckets holds one key value per bucket. Best for
+// small integer weights; memory grows with maxWeight.
+class DialBuckets {
+private:
+    long long ringSize;
+    BucketLists lists;
+    std::vector<long long> keyOf;
+    long long cursor = 0;  // Key of the bucket being drained; no queued key is lower
+    int count = 0;
+
+public:
+    DialBuckets(int n, long long maxWeight)
+        : ringSize(maxWeight + 1), lists(maxWeight + 1, n), keyOf(n) {}
+    
+    bool empty() const { return count == 0; }
+    
+    void push(int v, long long key) {
+        if (lists.queued(v)) {
+            if (key >= keyOf[v]) return;
+            lists.unlink(v);
+        } else {
+            if (count++ == 0) cursor = key;
+        }
+        keyOf[v] = key;
+        lists.link(v, key % ringSize);
+    }
+    
+    std::pair<long long, int> pop() {
+        while (lists.empty(cursor % ringSize)) {
+            cursor++;
+        }
+        int v = lists.first(cursor % ringSize);
+        lists.unlink(v);
+        count--;
+        return {keyOf[v], v};
+    }
+};
+
+// Radix heap (Ahuja, Mehlhorn, Orlin, Tarjan)
+// Push: O(1), Pop: O(log C) amortized for keys within C of the last pop
+// Bucket i > 0 holds keys whose highest bit differing from the last popped
+// key is bit i - 1; bucket 0 holds keys equal to it. Popping from an empty
+// bucket 0 finds the smallest key in the lowest non-empty bucket, makes it
+// the new last key and redistributes that bucket into lower ones. A key only
+// moves to lower buckets, at most 64 times over its life.
+class RadixHeap {
+private:
+    static const int BUCKETS = 65;
+    BucketLists lists;
+    std::vector<long long> keyOf;
+    long long last = 0;
+    int count = 0;
+    
+    int bucketFor(long long key) const {
+        return key == last ? 0 : 64 - __builtin_clzll((unsigned long long)(key ^ last));
+    }
+
+public:
+    RadixHeap(int n, long long = 0) : lists(BUCKETS, n), keyOf(n) {}
+    
+    bool empty() const { return count == 0; }
+    
+    void push(int v, long long key) {
+        if (lists.queued(v)) {
+            if (key >= keyOf[v]) return;
+            lists.unlink(v);
+        } else {
+            count++;
+        }
+        keyOf[v] = key;
+        lists.link(v, bucketFor(key));
+    }
+    
+    std::pair<long long, int> pop() {
+        if (lists.empty(0)) {
+            int bucket = 1;
+            while (lists.empty(bucket)) {
+                bucket++;
+            }
+            long long smallest = keyOf[lists.first(bucket)];
+            for (int v = lists.first(bucket); v != -1; v = lists.after(v)) {
+                smallest = std::min(smallest, keyOf[v]);
+            }
+            last = smallest;
+            for (int v = lists.first(bucket); v != -1; ) {
+                int following = lists.after(v);
+                lists.unlink(v);
+                lists.link(v, bucketFor(keyOf[v]));
+                v = following;
+            }
+        }
+        int v = lists.first(0);
+        lists.unlink(v);
+        count--;
+        return {keyOf[v], v};
+    }
+};
+
+#endif
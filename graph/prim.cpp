@@ -2,25 +2,28 @@
 #include <vector>
 #include <queue>
 #include <climits>
+#include "csr.h"
 
 // Prim's Minimum Spanning Tree Algorithm
 // Time Complexity: O((V + E) log V) with priority queue
 // Space Complexity: O(V)
+// Edges are scanned from a CSR graph (csr.h): each vertex's targets and
+// weights are contiguous ranges of two parallel arrays.
 
 class Graph {
 private:
     int V;
-    std::vector<std::vector<std::pair<int, int>>> adj;  // {vertex, weight}
-    
+    CSRBuilder adj;  // Weighted edge list, frozen to CSR on the first query
+
 public:
-    Graph(int vertices) : V(vertices), adj(vertices) {}
+    Graph(int vertices) : V(vertices), adj(vertices, true) {}
     
     void addEdge(int u, int v, int weight) {
-        adj[u].push_back({v, weight});
-        adj[v].push_back({u, weight});  // Undirected
+        adj.addUndirectedEdge(u, v, weight);
     }
     
     int primMST() {
+        const CSRGraph& graph = adj.graph();
         std::vector<bool> inMST(V, false);
         std::vector<int> key(V, INT_MAX);
         std::vector<int> parent(V, -1);
@@ -44,7 +47,10 @@ public:
             inMST[u] = true;
             mstWeight += weight;
             
-            for (auto& [v, w] : adj[u]) {
+            CSRGraph::Range<int> targets = graph.neighbors(u);
+            CSRGraph::Range<int> weights = graph.weightsOf(u);
+            for (int e = 0; e < targets.size(); e++) {
+                int v = targets[e], w = weights[e];
                 if (!inMST[v] && w < key[v]) {
                     key[v] = w;
                     parent[v] = u;
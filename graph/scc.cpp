@@ -2,81 +2,57 @@
 #include <vector>
 #include <stack>
 #include <algorithm>
+#include <functional>
+#include "csr.h"
+#include "scc.h"
 
-// Strongly Connected Components (Kosaraju's Algorithm)
+// Strongly Connected Components
 // Time Complexity: O(V + E)
 // Space Complexity: O(V)
+// Neighbours are scanned from a CSR graph (csr.h), one contiguous range per
+// vertex. components() runs the iterative engine in scc.h; tarjanSCC() below
+// is the textbook recursive form, kept for comparison.
 
 class Graph {
 private:
     int V;
-    std::vector<std::vector<int>> adj;
+    CSRBuilder adj;  // Edge list, frozen to CSR on the first query
+
+public:
+    Graph(int vertices) : V(vertices), adj(vertices) {}
     
-    void DFSUtil(int v, std::vector<bool>& visited, std::stack<int>& Stack) {
-        visited[v] = true;
-        
-        for (int u : adj[v]) {
-            if (!visited[u])
-                DFSUtil(u, visited, Stack);
-        }
-        
-        Stack.push(v);
+    void addEdge(int u, int v) {
+        adj.addEdge(u, v);
     }
     
-    void DFSUtilPrint(int v, std::vector<bool>& visited) {
-        visited[v] = true;
-        std::cout << v << " ";
-        
-        for (int u : adj[v]) {
-            if (!visited[u])
-                DFSUtilPrint(u, visited);
-        }
+    // Component number of every vertex, in reverse topological order
+    SCCDecomposition components() {
+        return stronglyConnectedComponents(adj.graph());
     }
     
-public:
-    Graph(int vertices) : V(vertices), adj(vertices) {}
-    
-    void addEdge(int u, int v) {
-        adj[u].push_back(v);
+    // Same partition, numbered by smallest vertex (scc.h)
+    SCCDecomposition parallelComponents(int threads = 0) {
+        return parallelStronglyConnectedComponents(adj.graph(), threads);
     }
     
-    Graph getTranspose() {
-        Graph g(V);
-        for (int v = 0; v < V; v++) {
-            for (int u : adj[v]) {
-                g.adj[u].push_back(v);
-            }
-        }
-        return g;
+    // One vertex per component; edges keep the component numbering
+    CSRGraph condensationDAG() {
+        const CSRGraph& graph = adj.graph();
+        return condensation(graph, stronglyConnectedComponents(graph));
     }
     
     void printSCCs() {
-        std::stack<int> Stack;
-        std::vector<bool> visited(V, false);
-        
-        // Step 1: Fill vertices in stack by finish time
-        for (int i = 0; i < V; i++) {
-            if (!visited[i])
-                DFSUtil(i, visited, Stack);
+        SCCDecomposition scc = components();
+        std::vector<std::vector<int>> members(scc.count);
+        for (int v = 0; v < V; v++) {
+            members[scc.component[v]].push_back(v);
         }
         
-        // Step 2: Get transpose graph
-        Graph gr = getTranspose();
-        
-        // Step 3: DFS on transpose in order of decreasing finish time
-        std::fill(visited.begin(), visited.end(), false);
-        
         std::cout << "Strongly Connected Components:" << std::endl;
-        int sccCount = 0;
-        while (!Stack.empty()) {
-            int v = Stack.top();
-            Stack.pop();
-            
-            if (!visited[v]) {
-                std::cout << "  SCC " << ++sccCount << ": ";
-                gr.DFSUtilPrint(v, visited);
-                std::cout << std::endl;
-            }
+        for (int c = 0; c < scc.count; c++) {
+            std::cout << "  SCC " << c + 1 << ": ";
+            for (int v : members[c]) std::cout << v << " ";
+            std::cout << std::endl;
         }
     }
     
@@ -91,12 +67,13 @@ public:
         
         std::cout << "Strongly Connected Components (Tarjan):" << std::endl;
         
+        const CSRGraph& graph = adj.graph();
         std::function<void(int)> tarjanDFS = [&](int u) {
             disc[u] = low[u] = time++;
             st.push(u);
             onStack[u] = true;
             
-            for (int v : adj[u]) {
+            for (int v : graph.neighbors(u)) {
                 if (disc[v] == -1) {
                     tarjanDFS(v);
                     low[u] = std::min(low[u], low[v]);
@@ -137,15 +114,65 @@ int main() {
     g.addEdge(0, 3);
     g.addEdge(3, 4);
     
-    std::cout << "Kosaraju's Algorithm:" << std::endl;
+    std::cout << "Iterative (Pearce) Algorithm:" << std::endl;
     g.printSCCs();
     
     std::cout << "\n";
     g.tarjanSCC();
     
+    CSRGraph dag = g.condensationDAG();
+    std::cout << "\nCondensation DAG (" << dag.vertices() << " components):" << std::endl;
+    for (int c = 0; c < dag.vertices(); c++) {
+        for (int d : dag.neighbors(c)) {
+            std::cout << "  SCC " << c + 1 << " -> SCC " << d + 1 << std::endl;
+        }
+    }
+    
+    // A 10^6-vertex cycle: the recursive version would need a million frames
+    int n = 1000000;
+    Graph cycle(n);
+    for (int v = 0; v < n; v++) {
+        cycle.addEdge(v, (v + 1) % n);
+    }
+    std::cout << "\nCycle of " << n << " vertices: " << cycle.components().count
+              << " component(s)" << std::endl;
+    
+    // Dependency-style graph: one giant cycle-rich core plus a fringe of
+    // small cycles and chains hanging off it
+    int m = 1 << 20;
+    Graph deps(m);
+    uint32_t state = 7;
+    auto next = [&state]() {
+        state = state * 1103515245 + 12345;
+        return state >> 8;
+    };
+    for (int v = 0; v < m; v++) {
+        if (v < m / 2) {
+            deps.addEdge(v, next() % (m / 2));
+            deps.addEdge(v, next() % (m / 2));
+        } else if (v % 4 != 0) {
+            deps.addEdge(v, v % 4 == 3 ? v - 3 : v + 1);  // Cycles of four
+        } else {
+            deps.addEdge(v, next() % m);
+        }
+    }
+    SCCDecomposition serial = deps.components();
+    SCCDecomposition parallel = deps.parallelComponents();
+    bool samePartition = serial.count == parallel.count;
+    std::vector<int> mapped(serial.count, -1);
+    for (int v = 0; v < m && samePartition; v++) {
+        int& image = mapped[serial.component[v]];
+        if (image == -1) image = parallel.component[v];
+        samePartition = image == parallel.component[v];
+    }
+    std::cout << "\nParallel forward-backward on " << m << " vertices: "
+              << parallel.count << " components, same partition as serial: "
+              << (samePartition ? "Yes" : "No") << std::endl;
+    
     std::cout << "\nKey Points:" << std::endl;
-    std::cout << "  - Kosaraju: Two DFS passes (original + transpose)" << std::endl;
+    std::cout << "  - Pearce: Tarjan with one rindex array and an explicit stack" << std::endl;
     std::cout << "  - Tarjan: Single DFS with low-link values" << std::endl;
+    std::cout << "  - Parallel: trim, peel the giant SCC, color the rest" << std::endl;
     std::cout << "  - SCCs form a DAG (condensation graph)" << std::endl;
     
     return 0;
@@ -0,0 +1,432 @@
+#ifndef SCC_H
+#define SCC_H
+
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include "csr.h"
+#include "threadpool.h"
+
+// Strongly Connected Components (Pearce's iterative Tarjan)
+// Time: O(V + E), Space: V ints + V bits + the DFS stacks
+// Tarjan's algorithm keeps index, low-link and on-stack flags per vertex.
+// Pearce's variant folds them into one rindex array: a vertex's rindex starts
+// as its DFS index and drops to the smallest index it can reach, and once its
+// component is complete the same slot is overwritten with the component
+// number. Component numbers count down from V - 1, so they always compare
+// above any index still in use and no on-stack flag is needed. The DFS runs
+// on an explicit stack of (vertex, next edge) frames, so deep graphs cannot
+// overflow the call stack, and no transposed copy of the graph is built.
+//
+// Components come out numbered in reverse topological order: every edge
+// between two components goes from a higher number to a lower one, and
+// component 0 is a sink.
+
+struct SCCDecomposition {
+    int count = 0;
+    std::vector<int> component;  // Component number of each vertex
+};
+
+inline SCCDecomposition stronglyConnectedComponents(const CSRGraph& graph) {
+    int V = graph.vertices();
+    const std::vector<int>& offsets = graph.offsetArray();
+    const std::vector<int>& targets = graph.targetArray();
+    
+    std::vector<int> rindex(V, 0);  // 0: not visited yet
+    std::vector<bool> root(V, false);
+    std::vector<std::pair<int, int>> frames;  // Vertex, next edge to scan
+    std::vector<int> pending;  // Visited, not yet assigned to a component
+    int index = 1, next = V - 1;
+    
+    auto visit = [&](int v) {
+        rindex[v] = index++;
+        root[v] = true;
+        frames.push_back({v, offsets[v]});
+    };
+    
+    for (int s = 0; s < V; s++) {
+        if (rindex[s] != 0) continue;
+        visit(s);
+        
+        while (!frames.empty()) {
+            int v = frames.back().first;
+            int e = frames.back().second;
+            if (e < offsets[v + 1]) {
+                frames.back().second++;
+                int w = targets[e];
+                if (rindex[w] == 0) {
+                    visit(w);
+                } else if (rindex[w] < rindex[v]) {
+                    rindex[v] = rindex[w];
+                    root[v] = false;
+                }
+                continue;
+            }
+            
+            // All edges of v scanned
+            frames.pop_back();
+            if (root[v]) {
+                // v heads a component: it and everything pending above it
+                index--;
+                while (!pending.empty() && rindex[v] <= rindex[pending.back()]) {
+                    rindex[pending.back()] = next;
+                    pending.pop_back();
+                    index--;
+                }
+                rindex[v] = next--;
+            } else {
+                pending.push_back(v);
+            }
+            
+            if (!frames.empty()) {
+                int parent = frames.back().first;
+                if (rindex[v] < rindex[parent]) {
+                    rindex[parent] = rindex[v];
+                    root[parent] = false;
+                }
+            }
+        }
+    }
+    
+    // Slots now hold V - 1, V - 2, ... in completion order; renumber from 0
+    SCCDecomposition result;
+    result.count = V - 1 - next;
+    for (int v = 0; v < V; v++) {
+        rindex[v] = V - 1 - rindex[v];
+    }
+    result.component = std::move(rindex);
+    return result;
+}
+
+// Condensation DAG: one vertex per component, one edge per distinct pair of
+// components joined by an edge of the graph
+inline CSRGraph condensation(const CSRGraph& graph, const SCCDecomposition& scc) {
+    std::vector<CSREdge> edges;
+    for (int u = 0; u < graph.vertices(); u++) {
+        for (int v : graph.neighbors(u)) {
+            int from = scc.component[u], to = scc.component[v];
+            if (from != to) edges.push_back({from, to, 1});
+        }
+    }
+    std::sort(edges.begin(), edges.end(), [](const CSREdge& a, const CSREdge& b) {
+        return a.from != b.from ? a.from < b.from : a.to < b.to;
+    });
+    edges.erase(std::unique(edges.begin(), edges.end(), [](const CSREdge& a, const CSREdge& b) {
+        return a.from == b.from && a.to == b.to;
+    }), edges.end());
+    return CSRGraph::fromEdges(scc.count, edges, false);
+}
+
+
+// Parallel SCC (forward-backward with trimming)
+// Time: O((V + E) / threads) per phase on graphs dominated by one giant
+// component; Space: O(V + E) for the transpose and per-vertex atomics
+//   1. Trim: a vertex with no remaining in-edges or no remaining out-edges
+//      is a component by itself. Removing it can expose more, so trimming
+//      repeats level by level with atomic degree decrements.
+//   2. Forward-backward: everything reachable from a pivot and also
+//      reaching it is the pivot's component. The pivot is the vertex with
+//      the largest in-degree * out-degree, which in practice lands in the
+//      giant component and peels it off with two parallel BFSs.
+//   3. Coloring: the remainder propagates the largest vertex id forward
+//      until it settles, so each vertex holds the largest id that reaches
+//      it. A vertex that keeps its own id roots a component: the vertices
+//      of its color that reach it backward. Trimming and coloring repeat
+//      while they make progress; the serial engine finishes the rest.
+// The partition is the one stronglyConnectedComponents() finds, whatever
+// the thread count. Components are numbered by their smallest vertex, not
+// topologically; run condensation() and a topological sort when the order
+// matters.
+class ParallelSCC {
+private:
+    static const int BLOCK = 256;            // Items per grab
+    static const int PARALLEL_ITEMS = 4096;  // Fewer items run on one thread
+    static const int SERIAL_VERTICES = 4096; // Remainder left to the serial engine
+    static const int COLOR_ROUNDS = 64;      // Propagation rounds before coloring gives up
+    static const int COLOR_WORK = 4;         // ... or queued vertices per active vertex
+    static const int PEEL_FRACTION = 8;      // A pass must remove 1/8 of the remainder
+    
+    const CSRGraph& out;
+    CSRGraph in;
+    int V;
+    int threads;
+    
+    std::vector<std::atomic<int>> label;  // -1 while active, else a member of its component
+    std::vector<std::atomic<int>> inDegree, outDegree, color;
+    std::vector<std::atomic<int>> mark;   // Stamp of the last search that reached a vertex
+    int stamp = 0;
+    std::vector<int> active;
+    std::vector<std::vector<int>> local;  // Per-thread output, gathered after each pass
+    WorkerPool pool;                      // Started once, reused by every level
+    
+    // fn(i, thread) for i in [0, count), handed out in blocks
+    template <typename Fn>
+    void parallelFor(long long count, Fn fn, int block = BLOCK) {
+        pool.parallelFor(count, fn, block, PARALLEL_ITEMS);
+    }
+    
+    std::vector<int> gather() {
+        std::vector<int> all;
+        for (std::vector<int>& part : local) {
+            all.insert(all.end(), part.begin(), part.end());
+            part.clear();
+        }
+        return all;
+    }
+    
+    bool isActive(int v) const {
+        return label[v].load(std::memory_order_relaxed) == -1;
+    }
+    
+    bool claim(int v, int component) {
+        int expected = -1;
+        return label[v].compare_exchange_strong(expected, component, std::memory_order_relaxed);
+    }
+    
+    void compact() {
+        active.erase(std::remove_if(active.begin(), active.end(),
+                                    [&](int v) { return !isActive(v); }),
+                     active.end());
+    }
+    
+    void trim() {
+        // Count first, then claim: a claim racing with a count would let a
+        // removed vertex go uncounted and later be subtracted anyway
+        parallelFor(active.size(), [&](long long i, int) {
+            int v = active[i];
+            int outgoing = 0, incoming = 0;
+            for (int w : out.neighbors(v)) outgoing += isActive(w);
+            for (int u : in.neighbors(v)) incoming += isActive(u);
+            outDegree[v].store(outgoing, std::memory_order_relaxed);
+            inDegree[v].store(incoming, std::memory_order_relaxed);
+        });
+        parallelFor(active.size(), [&](long long i, int t) {
+            int v = active[i];
+            if ((outDegree[v].load(std::memory_order_relaxed) == 0 ||
+                 inDegree[v].load(std::memory_order_relaxed) == 0) && claim(v, v)) {
+                local[t].push_back(v);
+            }
+        });
+        
+        std::vector<int> frontier = gather();
+        expand(frontier, [&](int v, std::vector<int>& found) {
+            for (int w : out.neighbors(v)) {
+                if (isActive(w) && inDegree[w].fetch_sub(1, std::memory_order_relaxed) == 1 &&
+                    claim(w, w)) {
+                    found.push_back(w);
+                }
+            }
+            for (int u : in.neighbors(v)) {
+                if (isActive(u) && outDegree[u].fetch_sub(1, std::memory_order_relaxed) == 1 &&
+                    claim(u, u)) {
+                    found.push_back(u);
+                }
+            }
+        });
+        compact();
+    }
+    
+    // Work-list closure: step(v, found) appends the vertices v releases.
+    // Neither trimming nor reachability needs level order, so a small work
+    // list drains serially as a stack and only a large one is split across
+    // the pool a level at a time. A long chain then costs a loop iteration
+    // per vertex instead of a pool round trip per level.
+    template <typename Step>
+    void expand(std::vector<int>& frontier, Step step) {
+        while (!frontier.empty()) {
+            if ((int)frontier.size() < PARALLEL_ITEMS) {
+                while (!frontier.empty() && (int)frontier.size() < PARALLEL_ITEMS) {
+                    int v = frontier.back();
+                    frontier.pop_back();
+                    step(v, frontier);
+                }
+                continue;
+            }
+            parallelFor(frontier.size(), [&](long long i, int t) {
+                step(frontier[i], local[t]);
+            });
+            frontier = gather();
+        }
+    }
+    
+    // Everything reachable from source over graph; visit(w) must claim w
+    // atomically and return whether this call did
+    template <typename Visit>
+    void reach(const CSRGraph& graph, int source, Visit visit) {
+        std::vector<int> frontier = {source};
+        expand(frontier, [&](int v, std::vector<int>& found) {
+            for (int w : graph.neighbors(v)) {
+                if (visit(w)) found.push_back(w);
+            }
+        });
+    }
+    
+    void forwardBackward() {
+        int pivot = active[0];
+        long long bestScore = -1;
+        for (int v : active) {
+            long long score = (long long)inDegree[v].load(std::memory_order_relaxed) *
+                              outDegree[v].load(std::memory_order_relaxed);
+            if (score > bestScore) {
+                bestScore = score;
+                pivot = v;
+            }
+        }
+        
+        int forward = ++stamp;
+        mark[pivot].store(forward, std::memory_order_relaxed);
+        reach(out, pivot, [&](int w) {
+            if (!isActive(w)) return false;
+            int seen = mark[w].load(std::memory_order_relaxed);
+            return seen != forward &&
+                   mark[w].compare_exchange_strong(seen, forward, std::memory_order_relaxed);
+        });
+        
+        // Backward inside the forward set only: that intersection is the SCC
+        claim(pivot, pivot);
+        reach(in, pivot, [&](int w) {
+            return mark[w].load(std::memory_order_relaxed) == forward && claim(w, pivot);
+        });
+        compact();
+    }
+    
+    // One coloring pass; false, with nothing removed, if the colors have
+    // not settled within COLOR_ROUNDS rounds or COLOR_WORK queued vertices
+    // per active vertex. Each round advances a color by one edge, so a long
+    // chain of small cycles whose ids grow against the edges would need a
+    // round per link, each re-queuing most of the chain.
+    bool coloring() {
+        parallelFor(active.size(), [&](long long i, int) {
+            color[active[i]].store(active[i], std::memory_order_relaxed);
+        });
+        
+        // Push the larger color along each edge; a vertex whose color rose
+        // is queued once for the next round
+        std::vector<int> frontier = active;
+        long long budget = (long long)COLOR_WORK * active.size();
+        for (int round = 0; !frontier.empty(); round++) {
+            budget -= frontier.size();
+            if (round == COLOR_ROUNDS || budget < 0) {
+                for (std::vector<int>& part : local) part.clear();
+                return false;
+            }
+            int queued = ++stamp;
+            parallelFor(frontier.size(), [&](long long i, int t) {
+                int v = frontier[i];
+                int c = color[v].load(std::memory_order_relaxed);
+                for (int w : out.neighbors(v)) {
+                    if (!isActive(w)) continue;
+                    int current = color[w].load(std::memory_order_relaxed);
+                    bool raised = false;
+                    while (current < c) {
+                        if (color[w].compare_exchange_weak(current, c, std::memory_order_relaxed)) {
+                            raised = true;
+                            break;
+                        }
+                    }
+                    if (raised && mark[w].exchange(queued, std::memory_order_relaxed) != queued) {
+                        local[t].push_back(w);
+                    }
+                }
+            });
+            frontier = gather();
+        }
+        
+        std::vector<int> roots;
+        for (int v : active) {
+            if (color[v].load(std::memory_order_relaxed) == v) roots.push_back(v);
+        }
+        
+        // Color classes are disjoint, so each root's backward search runs on
+        // one thread without contention; one root per grab balances sizes
+        parallelFor(roots.size(), [&](long long i, int) {
+            int root = roots[i];
+            std::vector<int> queue = {root};
+            claim(root, root);
+            for (size_t head = 0; head < queue.size(); head++) {
+                for (int u : in.neighbors(queue[head])) {
+                    if (color[u].load(std::memory_order_relaxed) == root && claim(u, root)) {
+                        queue.push_back(u);
+                    }
+                }
+            }
+        }, 1);
+        compact();
+        return true;
+    }
+    
+    // Serial engine on the subgraph induced by the active vertices
+    void finishSerially() {
+        std::vector<int> index(V, -1);
+        for (size_t i = 0; i < active.size(); i++) {
+            index[active[i]] = i;
+        }
+        std::vector<CSREdge> edges;
+        for (int v : active) {
+            for (int w : out.neighbors(v)) {
+                if (index[w] != -1) edges.push_back({index[v], index[w], 1});
+            }
+        }
+        SCCDecomposition rest = stronglyConnectedComponents(
+            CSRGraph::fromEdges(active.size(), edges, false, threads));
+        std::vector<int> member(rest.count, -1);
+        for (size_t i = 0; i < active.size(); i++) {
+            int& first = member[rest.component[i]];
+            if (first == -1) first = active[i];
+            label[active[i]].store(first, std::memory_order_relaxed);
+        }
+        active.clear();
+    }
+
+public:
+    ParallelSCC(const CSRGraph& graph, int threadCount = 0)
+        : out(graph), V(graph.vertices()),
+          threads(threadCount > 0 ? threadCount : std::max(1u, std::thread::hardware_concurrency())),
+          label(V), inDegree(V), outDegree(V), color(V), mark(V), local(threads), pool(threads) {
+        in = graph.transpose(threads);
+    }
+    
+    SCCDecomposition run() {
+        active.resize(V);
+        for (int v = 0; v < V; v++) {
+            label[v].store(-1, std::memory_order_relaxed);
+            mark[v].store(0, std::memory_order_relaxed);
+            active[v] = v;
+        }
+        
+        trim();
+        if (!active.empty()) forwardBackward();
+        // Coloring must keep paying for itself: a pass that cannot settle or
+        // peels off too little hands the rest to the linear serial engine.
+        // Every accepted pass shrinks the remainder by a fixed fraction, so
+        // the passes together cost O(COLOR_WORK * PEEL_FRACTION * (V + E)).
+        while (!active.empty()) {
+            trim();
+            if (active.empty()) break;
+            size_t before = active.size();
+            if ((int)before <= SERIAL_VERTICES || !coloring() ||
+                active.size() > before - before / PEEL_FRACTION) {
+                finishSerially();
+            }
+        }
+        
+        // Labels name a member vertex; renumber by smallest member
+        SCCDecomposition result;
+        result.component.assign(V, -1);
+        std::vector<int> number(V, -1);
+        for (int v = 0; v < V; v++) {
+            int& id = number[label[v].load(std::memory_order_relaxed)];
+            if (id == -1) id = result.count++;
+            result.component[v] = id;
+        }
+        return result;
+    }
+};
+
+inline SCCDecomposition parallelStronglyConnectedComponents(const CSRGraph& graph, int threads = 0) {
+    return ParallelSCC(graph, threads).run();
+}
+
+#endif
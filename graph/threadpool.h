@@ -0,0 +1,112 @@
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <atomic>
+#include <algorithm>
+
+// Fork-join worker pool
+// The worker threads start once and sleep on a condition variable between
+// jobs. Level-synchronous algorithms run one short job per level, and
+// creating and joining threads for each one costs more than a small level's
+// work. run(fn) calls fn(t) for every worker t, with the calling thread
+// acting as worker 0, and returns once all of them are done.
+class WorkerPool {
+private:
+    int size;
+    std::vector<std::thread> workers;
+    std::mutex lock;
+    std::condition_variable wake, finished;
+    const std::function<void(int)>* job = nullptr;
+    long long generation = 0;  // Bumped per job, so a worker runs each once
+    int participants = 0;
+    int pending = 0;
+    bool stopping = false;
+    
+    void workerLoop(int id) {
+        long long seen = 0;
+        std::unique_lock<std::mutex> guard(lock);
+        while (true) {
+            wake.wait(guard, [&] { return stopping || generation != seen; });
+            if (stopping) return;
+            seen = generation;
+            if (id >= participants) continue;
+            const std::function<void(int)>* current = job;
+            guard.unlock();
+            (*current)(id);
+            guard.lock();
+            if (--pending == 0) finished.notify_one();
+        }
+    }
+
+public:
+    explicit WorkerPool(int threads) : size(std::max(1, threads)) {
+        for (int t = 1; t < size; t++) {
+            workers.emplace_back(&WorkerPool::workerLoop, this, t);
+        }
+    }
+    
+    ~WorkerPool() {
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            stopping = true;
+        }
+        wake.notify_all();
+        for (std::thread& worker : workers) {
+            worker.join();
+        }
+    }
+    
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+    
+    int threads() const { return size; }
+    
+    // fn(t) for t in [0, count), count capped at the pool size
+    void run(const std::function<void(int)>& fn, int count = 0) {
+        count = count <= 0 ? size : std::min(count, size);
+        if (count == 1) {
+            fn(0);
+            return;
+        }
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            job = &fn;
+            participants = count;
+            pending = count - 1;
+            generation++;
+        }
+        wake.notify_all();
+        fn(0);
+        std::unique_lock<std::mutex> guard(lock);
+        finished.wait(guard, [&] { return pending == 0; });
+    }
+    
+    // fn(i, t) for i in [0, count), handed out in blocks of `block`; counts
+    // below serialBelow run on the calling thread without waking anyone
+    template <typename Fn>
+    void parallelFor(long long count, Fn fn, int block = 256, long long serialBelow = 4096) {
+        std::atomic<long long> cursor(0);
+        auto body = [&](int t) {
+            while (true) {
+                long long first = cursor.fetch_add(block);
+                if (first >= count) break;
+                long long last = std::min(count, first + block);
+                for (long long i = first; i < last; i++) {
+                    fn(i, t);
+                }
+            }
+        };
+        if (count < serialBelow) {
+            body(0);
+        } else {
+            run(body);
+        }
+    }
+};
+
+#endif
@@ -1,23 +1,26 @@
 #include <iostream>
 #include <vector>
 #include <stack>
-#include <list>
 #include <queue>
+#include "csr.h"
+#include "dagschedule.h"
 
 // Topological Sort using DFS
 // Time Complexity: O(V + E)
 // Space Complexity: O(V)
 // Only valid for Directed Acyclic Graphs (DAGs)
+// Neighbours are scanned from a CSR graph (csr.h), one contiguous range per
+// vertex.
 
 class Graph {
 private:
     int V;
-    std::vector<std::list<int>> adj;
+    CSRBuilder adj;  // Edge list, frozen to CSR on the first query
     
     void topologicalSortUtil(int v, std::vector<bool>& visited, std::stack<int>& stack) {
         visited[v] = true;
         
-        for (int neighbor : adj[v]) {
+        for (int neighbor : adj.graph().neighbors(v)) {
             if (!visited[neighbor]) {
                 topologicalSortUtil(neighbor, visited, stack);
             }
@@ -25,12 +28,12 @@ private:
         
         stack.push(v);  // Push after visiting all descendants
     }
-    
+
 public:
     Graph(int vertices) : V(vertices), adj(vertices) {}
     
     void addEdge(int u, int v) {
-        adj[u].push_back(v);
+        adj.addEdge(u, v);
     }
     
     std::vector<int> topologicalSort() {
@@ -54,10 +57,11 @@ public:
     
     // Kahn's algorithm (BFS-based)
     std::vector<int> topologicalSortBFS() {
+        const CSRGraph& graph = adj.graph();
         std::vector<int> inDegree(V, 0);
         
         for (int u = 0; u < V; u++) {
-            for (int v : adj[u]) {
+            for (int v : graph.neighbors(u)) {
                 inDegree[v]++;
             }
         }
@@ -76,7 +80,7 @@ public:
             queue.pop();
             result.push_back(u);
             
-            for (int v : adj[u]) {
+            for (int v : graph.neighbors(u)) {
                 inDegree[v]--;
                 if (inDegree[v] == 0) {
                     queue.push(v);
@@ -86,6 +90,12 @@ public:
         
         return result;
     }
+    
+    // Kahn's algorithm with each level of ready vertices processed in
+    // parallel (dagschedule.h)
+    TopologicalLevels topologicalSortParallel(int threads = 0) {
+        return topologicalLevels(adj.graph(), threads);
+    }
 };
 
 int main() {
@@ -110,5 +120,10 @@ int main() {
     for (int v : order) std::cout << v << " ";
     std::cout << std::endl;
     
+    std::cout << "Level-synchronous parallel Kahn: ";
+    TopologicalLevels levels = g.topologicalSortParallel();
+    for (int v : levels.order) std::cout << v << " ";
+    std::cout << "(" << levels.levels() << " levels)" << std::endl;
+    
     return 0;
 }
\ No newline at end of file
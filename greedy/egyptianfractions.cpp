@@ -2,6 +2,12 @@
 #include <vector>
 #include <algorithm>
 #include <numeric>
+#include <string>
+#include <cstdint>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <stdexcept>
 
 // Egyptian Fractions (Greedy Algorithm)
 // Represent a fraction as sum of unit fractions
@@ -46,7 +52,244 @@ std::ostream& operator<<(std::ostream& os, const Fraction& f) {
     return os;
 }
 
+// Arbitrary precision non-negative integer
+// Base 2^32 limbs, least significant first, no leading zero limbs (zero is
+// empty). Greedy denominators roughly square at every step, so they leave
+// 64 bits after a handful of terms.
+class BigInt {
+private:
+    std::vector<uint32_t> limbs;
+    
+    void trim() {
+        while (!limbs.empty() && limbs.back() == 0) {
+            limbs.pop_back();
+        }
+    }
+    
+    // Divide by a single limb in place; returns the remainder
+    uint32_t divSmall(uint32_t divisor) {
+        uint64_t rem = 0;
+        for (size_t i = limbs.size(); i-- > 0;) {
+            uint64_t cur = (rem << 32) | limbs[i];
+            limbs[i] = (uint32_t)(cur / divisor);
+            rem = cur % divisor;
+        }
+        trim();
+        return (uint32_t)rem;
+    }
+
+public:
+    BigInt(uint64_t x = 0) {
+        while (x > 0) {
+            limbs.push_back((uint32_t)x);
+            x >>= 32;
+        }
+    }
+    
+    bool isZero() const { return limbs.empty(); }
+    bool fitsU64() const { return limbs.size() <= 2; }
+    
+    uint64_t toU64() const {
+        uint64_t x = 0;
+        for (size_t i = limbs.size(); i-- > 0;) {
+            x = (x << 32) | limbs[i];
+        }
+        return x;
+    }
+    
+    friend int compare(const BigInt& a, const BigInt& b) {
+        if (a.limbs.size() != b.limbs.size()) {
+            return a.limbs.size() < b.limbs.size() ? -1 : 1;
+        }
+        for (size_t i = a.limbs.size(); i-- > 0;) {
+            if (a.limbs[i] != b.limbs[i]) {
+                return a.limbs[i] < b.limbs[i] ? -1 : 1;
+            }
+        }
+        return 0;
+    }
+    
+    friend bool operator<(const BigInt& a, const BigInt& b) { return compare(a, b) < 0; }
+    friend bool operator>(const BigInt& a, const BigInt& b) { return compare(a, b) > 0; }
+    friend bool operator<=(const BigInt& a, const BigInt& b) { return compare(a, b) <= 0; }
+    friend bool operator>=(const BigInt& a, const BigInt& b) { return compare(a, b) >= 0; }
+    friend bool operator==(const BigInt& a, const BigInt& b) { return a.limbs == b.limbs; }
+    friend bool operator!=(const BigInt& a, const BigInt& b) { return a.limbs != b.limbs; }
+    
+    BigInt& operator+=(const BigInt& other) {
+        if (other.limbs.size() > limbs.size()) {
+            limbs.resize(other.limbs.size(), 0);
+        }
+        uint64_t carry = 0;
+        for (size_t i = 0; i < limbs.size(); i++) {
+            uint64_t sum = carry + limbs[i] + (i < other.limbs.size() ? other.limbs[i] : 0);
+            limbs[i] = (uint32_t)sum;
+            carry = sum >> 32;
+        }
+        if (carry) limbs.push_back((uint32_t)carry);
+        return *this;
+    }
+    
+    // Requires *this >= other
+    BigInt& operator-=(const BigInt& other) {
+        int64_t borrow = 0;
+        for (size_t i = 0; i < limbs.size(); i++) {
+            int64_t diff = (int64_t)limbs[i] - borrow - (i < other.limbs.size() ? other.limbs[i] : 0);
+            borrow = diff < 0;
+            limbs[i] = (uint32_t)(diff + (borrow << 32));
+        }
+        trim();
+        return *this;
+    }
+    
+    friend BigInt operator+(BigInt a, const BigInt& b) { return a += b; }
+    friend BigInt operator-(BigInt a, const BigInt& b) { return a -= b; }
+    
+    friend BigInt operator*(const BigInt& a, const BigInt& b) {
+        BigInt result;
+        if (a.isZero() || b.isZero()) return result;
+        result.limbs.assign(a.limbs.size() + b.limbs.size(), 0);
+        for (size_t i = 0; i < a.limbs.size(); i++) {
+            uint64_t carry = 0;
+            for (size_t j = 0; j < b.limbs.size(); j++) {
+                uint64_t cur = (uint64_t)a.limbs[i] * b.limbs[j] + result.limbs[i + j] + carry;
+                result.limbs[i + j] = (uint32_t)cur;
+                carry = cur >> 32;
+            }
+            result.limbs[i + b.limbs.size()] = (uint32_t)carry;
+        }
+        result.trim();
+        return result;
+    }
+    
+    // Schoolbook long division (Knuth's algorithm D): normalize so the
+    // divisor's top limb has its high bit set, then each quotient limb is
+    // estimated from the top two limbs and corrected at most twice.
+    friend void divMod(const BigInt& a, const BigInt& b, BigInt& quotient, BigInt& remainder) {
+        if (a < b) {
+            quotient = BigInt();
+            remainder = a;
+            return;
+        }
+        if (b.limbs.size() == 1) {
+            quotient = a;
+            remainder = BigInt(quotient.divSmall(b.limbs[0]));
+            return;
+        }
+        
+        int shift = __builtin_clz(b.limbs.back());
+        size_t n = b.limbs.size(), m = a.limbs.size() - n;
+        std::vector<uint32_t> v(n), u(a.limbs.size() + 1);
+        for (size_t i = n; i-- > 0;) {
+            v[i] = (b.limbs[i] << shift) | (shift && i > 0 ? b.limbs[i - 1] >> (32 - shift) : 0);
+        }
+        u[a.limbs.size()] = shift ? a.limbs.back() >> (32 - shift) : 0;
+        for (size_t i = a.limbs.size(); i-- > 0;) {
+            u[i] = (a.limbs[i] << shift) | (shift && i > 0 ? a.limbs[i - 1] >> (32 - shift) : 0);
+        }
+        
+        quotient.limbs.assign(m + 1, 0);
+        const uint64_t BASE = uint64_t(1) << 32;
+        for (size_t j = m + 1; j-- > 0;) {
+            uint64_t top = ((uint64_t)u[j + n] << 32) | u[j + n - 1];
+            uint64_t qhat = top / v[n - 1];
+            uint64_t rhat = top % v[n - 1];
+            while (qhat >= BASE || qhat * v[n - 2] > ((rhat << 32) | u[j + n - 2])) {
+                qhat--;
+                rhat += v[n - 1];
+                if (rhat >= BASE) break;
+            }
+            
+            // u[j .. j+n] -= qhat * v
+            int64_t borrow = 0;
+            uint64_t carry = 0;
+            for (size_t i = 0; i < n; i++) {
+                uint64_t product = qhat * v[i] + carry;
+                carry = product >> 32;
+                int64_t diff = (int64_t)u[i + j] - borrow - (uint32_t)product;
+                borrow = diff < 0;
+                u[i + j] = (uint32_t)(diff + (borrow << 32));
+            }
+            int64_t diff = (int64_t)u[j + n] - borrow - (int64_t)carry;
+            u[j + n] = (uint32_t)diff;
+            
+            // qhat was one too large: add v back
+            if (diff < 0) {
+                qhat--;
+                uint64_t sum = 0;
+                for (size_t i = 0; i < n; i++) {
+                    sum = (uint64_t)u[i + j] + v[i] + (sum >> 32);
+                    u[i + j] = (uint32_t)sum;
+                }
+                u[j + n] += (uint32_t)(sum >> 32);
+            }
+            quotient.limbs[j] = (uint32_t)qhat;
+        }
+        quotient.trim();
+        
+        remainder.limbs.assign(n, 0);
+        for (size_t i = 0; i < n; i++) {
+            remainder.limbs[i] = (u[i] >> shift) | (shift ? (uint32_t)((uint64_t)u[i + 1] << (32 - shift)) : 0);
+        }
+        remainder.trim();
+    }
+    
+    friend BigInt operator/(const BigInt& a, const BigInt& b) {
+        BigInt q, r;
+        divMod(a, b, q, r);
+        return q;
+    }
+    
+    friend BigInt operator%(const BigInt& a, const BigInt& b) {
+        BigInt q, r;
+        divMod(a, b, q, r);
+        return r;
+    }
+    
+    friend BigInt gcd(BigInt a, BigInt b) {
+        while (!b.isZero()) {
+            BigInt r = a % b;
+            a = std::move(b);
+            b = std::move(r);
+        }
+        return a;
+    }
+    
+    std::string toString() const {
+        if (isZero()) return "0";
+        BigInt x = *this;
+        std::string digits;
+        while (!x.isZero()) {
+            uint32_t chunk = x.divSmall(1000000000);
+            for (int k = 0; k < 9; k++) {
+                digits.push_back('0' + chunk % 10);
+                chunk /= 10;
+            }
+        }
+        while (digits.size() > 1 && digits.back() == '0') {
+            digits.pop_back();
+        }
+        std::reverse(digits.begin(), digits.end());
+        return digits;
+    }
+    
+    friend std::ostream& operator<<(std::ostream& os, const BigInt& x) {
+        return os << x.toString();
+    }
+};
+
+// a * b, or an error once the product leaves long long; greedy denominators
+// roughly square at every step, so that happens after a few terms
+long long checkedMultiply(long long a, long long b) {
+    long long product;
+    if (__builtin_mul_overflow(a, b, &product)) {
+        throw std::runtime_error("denominator exceeds long long, use egyptianFractionsGreedyBig");
+    }
+    return product;
+}
+
 // Greedy algorithm for Egyptian Fractions
+// Throws std::runtime_error when a denominator does not fit in long long
 std::vector<long long> egyptianFractionsGreedy(long long num, long long den) {
     std::vector<long long> result;
     Fraction frac(num, den);
@@ -56,14 +299,15 @@ std::vector<long long> egyptianFractionsGreedy(long long num, long long den) {
         long long unitDen = (frac.den + frac.num - 1) / frac.num;
         result.push_back(unitDen);
         
-        // Subtract 1/unitDen from fraction
-        frac = frac - Fraction(1, unitDen);
+        // Subtract 1/unitDen: num/den - 1/d = (num*d - den) / (den*d)
+        frac = Fraction(checkedMultiply(frac.num, unitDen) - frac.den, checkedMultiply(frac.den, unitDen));
     }
     
     return result;
 }
 
 // Alternative: Fibonacci-Sylvester algorithm
+// Throws std::runtime_error when a denominator does not fit in long long
 std::vector<long long> egyptianFractionsFibonacci(long long num, long long den) {
     std::vector<long long> result;
     
@@ -71,8 +315,8 @@ std::vector<long long> egyptianFractionsFibonacci(long long num, long long den)
         long long q = (den + num - 1) / num;
         result.push_back(q);
         
-        num = num * q - den;
-        den = den * q;
+        num = checkedMultiply(num, q) - den;
+        den = checkedMultiply(den, q);
         
         // Simplify
         long long g = std::gcd(num, den);
@@ -83,43 +327,185 @@ std::vector<long long> egyptianFractionsFibonacci(long long num, long long den)
     return result;
 }
 
-// Find optimal Egyptian fraction with minimum terms
-// (This is NP-hard in general, so we use heuristics)
-std::vector<long long> egyptianFractionsOptimal(long long num, long long den, int maxTerms = 10) {
-    if (num == 0) return {};
-    if (num == 1) return {den};
+// Greedy with exact arithmetic
+// Same expansion as egyptianFractionsGreedy, without overflow
+std::vector<BigInt> egyptianFractionsGreedyBig(long long num, long long den) {
+    std::vector<BigInt> result;
+    BigInt a(num), b(den);
+    
+    while (!a.isZero()) {
+        // a/b - 1/d = (a*d - b) / (b*d) with d = ceil(b/a)
+        BigInt d = (b + a - BigInt(1)) / a;
+        result.push_back(d);
+        a = a * d - b;
+        b = b * d;
+        BigInt g = gcd(a, b);
+        if (!a.isZero()) {
+            a = a / g;
+            b = b / g;
+        }
+    }
+    
+    return result;
+}
+
+// Exact minimal-term solver
+// Iterative deepening on the number of terms k. At depth k the DFS picks
+// strictly increasing denominators, and with terms t left for a remainder
+// a/b the next denominator d is bounded on both sides:
+//   d >= ceil(b / a)      (1/d cannot exceed what is left)
+//   d <= floor(t * b / a) (t terms of at most 1/d must reach a/b)
+// The last term is forced: a must divide b. Among k-term representations
+// the one with the smallest largest denominator wins (ties: compare from the
+// largest down), and once one is known any branch whose next denominator
+// already exceeds that largest denominator is cut.
+// The top-level denominators are independent subtrees; threads claim them
+// from a shared counter and share the best largest denominator for pruning.
+class EgyptianSolver {
+private:
+    static const uint64_t NO_BOUND = UINT64_MAX;
+    
+    std::atomic<uint64_t> bound{NO_BOUND};  // Best largest denominator if it fits in 64 bits
+    std::mutex bestLock;
+    std::vector<BigInt> best;
     
-    std::vector<long long> best = egyptianFractionsGreedy(num, den);
+    // Smaller largest denominator first, then compare from the largest down
+    static bool better(const std::vector<BigInt>& a, const std::vector<BigInt>& b) {
+        if (b.empty()) return true;
+        for (size_t i = a.size(); i-- > 0;) {
+            int c = compare(a[i], b[i]);
+            if (c != 0) return c < 0;
+        }
+        return false;
+    }
+    
+    // d is too large to beat the best: strictly beyond its largest denominator
+    bool pastBound(const BigInt& d) const {
+        uint64_t limit = bound.load(std::memory_order_relaxed);
+        return limit != NO_BOUND && (!d.fitsU64() || d.toU64() > limit);
+    }
     
-    // Try splitting in different ways
-    for (long long d = 2; d <= den && best.size() > 2; d++) {
-        if (den % d == 0) {
-            long long newNum = num;
-            long long newDen = den / d;
+    void record(const std::vector<BigInt>& terms) {
+        std::lock_guard<std::mutex> guard(bestLock);
+        if (!better(terms, best)) return;
+        best = terms;
+        if (terms.back().fitsU64()) {
+            bound.store(terms.back().toU64(), std::memory_order_relaxed);
+        }
+    }
+    
+    void search(const BigInt& a, const BigInt& b, int termsLeft, const BigInt& minDen,
+                std::vector<BigInt>& terms) {
+        if (termsLeft == 1) {
+            BigInt q, r;
+            divMod(b, a, q, r);
+            if (r.isZero() && q >= minDen && !pastBound(q)) {
+                terms.push_back(q);
+                record(terms);
+                terms.pop_back();
+            }
+            return;
+        }
+        
+        BigInt lo = std::max(minDen, (b + a - BigInt(1)) / a);
+        BigInt hi = BigInt(termsLeft) * b / a;
+        for (BigInt d = lo; d <= hi && !pastBound(d); d += BigInt(1)) {
+            BigInt na = a * d;
+            if (na <= b) continue;  // 1/d is all that is left, but more terms must follow
+            na -= b;
+            BigInt nb = b * d;
+            BigInt g = gcd(na, nb);
             
-            if (newNum < newDen) {
-                auto partial = egyptianFractionsGreedy(newNum, newDen);
-                if (partial.size() + 1 < best.size()) {
-                    partial.push_back(d);
-                    std::sort(partial.begin(), partial.end());
-                    best = partial;
-                }
+            terms.push_back(d);
+            search(na / g, nb / g, termsLeft - 1, d + BigInt(1), terms);
+            terms.pop_back();
+        }
+    }
+    
+    bool solveDepth(const BigInt& a, const BigInt& b, int depth, int threads) {
+        if (depth == 1) {
+            std::vector<BigInt> terms;
+            search(a, b, 1, BigInt(1), terms);
+            return !best.empty();
+        }
+        
+        // Top-level denominators run over [lo, hi] with hi = depth * den / num,
+        // which can pass 2^64 for a large den; threads claim offsets from lo
+        BigInt lo = (b + a - BigInt(1)) / a;
+        BigInt hi = BigInt(depth) * b / a;
+        std::atomic<uint64_t> next{0};
+        
+        auto worker = [&] {
+            std::vector<BigInt> terms;
+            while (true) {
+                BigInt d = lo + BigInt(next.fetch_add(1));
+                if (d > hi || pastBound(d)) break;
+                BigInt na = a * d;
+                if (na <= b) continue;
+                na -= b;
+                BigInt nb = b * d;
+                BigInt g = gcd(na, nb);
+                
+                terms.assign(1, d);
+                search(na / g, nb / g, depth - 1, d + BigInt(1), terms);
             }
+        };
+        
+        std::vector<std::thread> pool;
+        for (int t = 1; t < threads; t++) {
+            pool.emplace_back(worker);
+        }
+        worker();
+        for (std::thread& thread : pool) {
+            thread.join();
+        }
+        return !best.empty();
+    }
+
+public:
+    // Empty when no representation with at most maxTerms terms exists
+    std::vector<BigInt> solve(long long num, long long den, int maxTerms, int threads) {
+        BigInt a(num), b(den);
+        BigInt g = gcd(a, b);
+        a = a / g;
+        b = b / g;
+        
+        for (int depth = 1; depth <= maxTerms; depth++) {
+            if (solveDepth(a, b, depth, threads)) break;
         }
+        return best;
+    }
+};
+
+// Minimum number of terms, exactly. The search is exponential in the number
+// of terms; maxTerms caps the deepening, and past it the greedy expansion is
+// returned instead.
+std::vector<BigInt> egyptianFractionsOptimal(long long num, long long den, int maxTerms = 10,
+                                             int threads = 0) {
+    if (num <= 0 || den <= 0) return {};
+    if (threads <= 0) {
+        threads = std::max(1u, std::thread::hardware_concurrency());
     }
     
-    return best;
+    EgyptianSolver solver;
+    std::vector<BigInt> best = solver.solve(num, den, maxTerms, threads);
+    return best.empty() ? egyptianFractionsGreedyBig(num, den) : best;
 }
 
 // Check if representation is valid
-bool verifyEgyptianFraction(long long num, long long den, const std::vector<long long>& egyptian) {
-    Fraction sum(0, 1);
-    
-    for (long long d : egyptian) {
-        sum = Fraction(sum.num * d + sum.den, sum.den * d);
+bool verifyEgyptianFraction(long long num, long long den, const std::vector<BigInt>& egyptian) {
+    // sumNum / sumDen accumulated exactly, compared by cross-multiplying
+    BigInt sumNum(0), sumDen(1);
+    for (const BigInt& d : egyptian) {
+        sumNum = sumNum * d + sumDen;
+        sumDen = sumDen * d;
     }
-    
-    return sum.num * den == num * sum.den;
+    return sumNum * BigInt(den) == BigInt(num) * sumDen;
+}
+
+// Sums of long long terms can pass 64 bits too, so they are checked exactly
+bool verifyEgyptianFraction(long long num, long long den, const std::vector<long long>& egyptian) {
+    return verifyEgyptianFraction(num, den, std::vector<BigInt>(egyptian.begin(), egyptian.end()));
 }
 
 void printEgyptianFraction(long long num, long long den, const std::vector<long long>& egyptian) {
@@ -131,6 +517,15 @@ void printEgyptianFraction(long long num, long long den, const std::vector<long
     std::cout << std::endl;
 }
 
+void printEgyptianFraction(long long num, long long den, const std::vector<BigInt>& egyptian) {
+    std::cout << num << "/" << den << " = ";
+    for (size_t i = 0; i < egyptian.size(); i++) {
+        if (i > 0) std::cout << " + ";
+        std::cout << "1/" << egyptian[i];
+    }
+    std::cout << std::endl;
+}
+
 int main() {
     std::cout << "=== Egyptian Fractions (Greedy) ===" << std::endl;
     std::cout << "Representing fractions as sum of unit fractions" << std::endl << std::endl;
@@ -152,13 +547,39 @@ int main() {
     std::cout << "\nExample 3 (Comparing algorithms):" << std::endl;
     long long num3 = 5, den3 = 121;
     
-    auto greedy = egyptianFractionsGreedy(num3, den3);
-    std::cout << "Greedy (" << greedy.size() << " terms): ";
-    printEgyptianFraction(num3, den3, greedy);
+    // Both long long expansions outgrow 64 bits here; exact arithmetic does not
+    try {
+        auto greedy = egyptianFractionsGreedy(num3, den3);
+        std::cout << "Greedy (" << greedy.size() << " terms): ";
+        printEgyptianFraction(num3, den3, greedy);
+    } catch (const std::runtime_error& error) {
+        std::cout << "Greedy (long long): " << error.what() << std::endl;
+    }
+    try {
+        auto fib = egyptianFractionsFibonacci(num3, den3);
+        std::cout << "Fibonacci (" << fib.size() << " terms): ";
+        printEgyptianFraction(num3, den3, fib);
+    } catch (const std::runtime_error& error) {
+        std::cout << "Fibonacci (long long): " << error.what() << std::endl;
+    }
     
-    auto fib = egyptianFractionsFibonacci(num3, den3);
-    std::cout << "Fibonacci (" << fib.size() << " terms): ";
-    printEgyptianFraction(num3, den3, fib);
+    auto greedyBig = egyptianFractionsGreedyBig(num3, den3);
+    std::cout << "Greedy, exact (" << greedyBig.size() << " terms): ";
+    printEgyptianFraction(num3, den3, greedyBig);
+    std::cout << "Valid: " << (verifyEgyptianFraction(num3, den3, greedyBig) ? "Yes" : "No") << std::endl;
+    
+    auto optimal = egyptianFractionsOptimal(num3, den3);
+    std::cout << "Minimal (" << optimal.size() << " terms): ";
+    printEgyptianFraction(num3, den3, optimal);
+    
+    // Minimal-term search: iterative deepening across threads
+    std::cout << "\nMinimal representations:" << std::endl;
+    std::vector<std::pair<long long, long long>> hard = {{4, 5}, {7, 15}, {19, 45}, {8, 11}, {5, 31}, {17, 99}};
+    for (auto [num, den] : hard) {
+        auto terms = egyptianFractionsOptimal(num, den);
+        std::cout << "  ";
+        printEgyptianFraction(num, den, terms);
+    }
     
     // Example 4: Famous examples
     std::cout << "\nFamous Examples:" << std::endl;
@@ -2,6 +2,10 @@
 #include <vector>
 #include <string>
 #include <algorithm>
+#include <cstdint>
+#include <climits>
+#include <stdexcept>
+#include "../dp/subsetsum.h"
 
 // Quasi-Omnipotence: Problems solvable by clever reductions
 // Demonstrates how complex problems reduce to known solvable ones
@@ -28,7 +32,7 @@ private:
         }
         return false;
     }
-    
+
 public:
     BipartiteGraph(int u, int v) : U(u), V(v), adj(u) {}
     
@@ -101,29 +105,24 @@ public:
 // Example 3: Subset Sum -> Partition
 // Partition problem reduces to Subset Sum
 
+// Bitset engine shared with dp/subsetsum.cpp: 64 sums per word instead of
+// an (n+1) x (target+1) table
 bool subsetSum(const std::vector<int>& arr, int target) {
-    int n = arr.size();
-    std::vector<std::vector<bool>> dp(n + 1, std::vector<bool>(target + 1, false));
-    
-    for (int i = 0; i <= n; i++)
-        dp[i][0] = true;
-    
-    for (int i = 1; i <= n; i++) {
-        for (int j = 1; j <= target; j++) {
-            dp[i][j] = dp[i-1][j];
-            if (j >= arr[i-1])
-                dp[i][j] = dp[i][j] || dp[i-1][j - arr[i-1]];
-        }
-    }
-    
-    return dp[n][target];
+    if (target < 0) return false;
+    SubsetSumBitset engine(target);
+    engine.addAll(arr);
+    return engine.reachable(target);
 }
 
 bool canPartition(const std::vector<int>& arr) {
-    int sum = 0;
-    for (int x : arr) sum += x;
+    long long sum = 0;
+    for (int x : arr) {
+        if (x < 0) throw std::runtime_error("canPartition: negative element");
+        sum += x;
+    }
     
     if (sum % 2 != 0) return false;
+    if (sum / 2 > INT_MAX) throw std::runtime_error("canPartition: half sum exceeds int range");
     
     // Partition reduces to: subset sum with target = sum/2
     return subsetSum(arr, sum / 2);
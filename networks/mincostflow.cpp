@@ -3,6 +3,7 @@
 #include <queue>
 #include <algorithm>
 #include <climits>
+#include "../graph/monotonequeue.h"
 
 using namespace std;
 
@@ -32,8 +33,14 @@ using namespace std;
  * 3. Repeat until desired flow achieved
  * 
  * Uses modified Dijkstra to handle negative costs via potentials
+ *
+ * The Dijkstra queue is a template parameter: IndexedDaryHeap<4> (default),
+ * DialBuckets or RadixHeap from graph/monotonequeue.h. Reduced costs are
+ * non-negative, so the monotone queues apply; all three lower keys in place
+ * instead of piling up stale entries.
  */
 
+template <typename Queue = IndexedDaryHeap<4>>
 class MinCostFlow {
 private:
     struct Edge {
@@ -71,17 +78,23 @@ private:
         parent.assign(n, -1);
         parentEdge.assign(n, -1);
         
-        priority_queue<pair<int, int>, vector<pair<int, int>>, 
-                      greater<pair<int, int>>> pq;
+        // Dial's ring must span the largest reduced cost
+        long long maxReduced = 0;
+        for (int u = 0; u < n; u++) {
+            if (potential[u] == INF) continue;
+            for (const Edge& e : graph[u]) {
+                if (e.cap > 0 && potential[e.to] != INF) {
+                    maxReduced = max(maxReduced, (long long)e.cost + potential[u] - potential[e.to]);
+                }
+            }
+        }
+        Queue pq(n, maxReduced);
         
         dist[source] = 0;
-        pq.push({0, source});
+        pq.push(source, 0);
         
         while (!pq.empty()) {
-            auto [d, u] = pq.top();
-            pq.pop();
-            
-            if (d > dist[u]) continue;
+            int u = pq.pop().second;
             
             for (int i = 0; i < graph[u].size(); i++) {
                 const Edge& e = graph[u][i];
@@ -94,7 +107,7 @@ private:
                         dist[e.to] = dist[u] + reducedCost;
                         parent[e.to] = u;
                         parentEdge[e.to] = i;
-                        pq.push({dist[e.to], e.to});
+                        pq.push(e.to, dist[e.to]);
                     }
                 }
             }
@@ -102,7 +115,7 @@ private:
         
         return dist[sink] != INF;
     }
-    
+
 public:
     MinCostFlow(int vertices) : n(vertices) {
         graph.resize(n);
@@ -232,7 +245,7 @@ private:
         reverse(cycle.begin(), cycle.end());
         return true;
     }
-    
+
 public:
     CycleCanceling(int vertices) : n(vertices) {
         graph.resize(n);
@@ -469,15 +482,39 @@ void testSupplyChain() {
     cout << "Supply chain optimized to minimize costs" << endl << endl;
 }
 
+void testQueueChoice() {
+    cout << "=== Dijkstra Queue Choice ===" << endl;
+    
+    // Transportation problem from above on each monotone queue
+    auto solve = [](auto transport) {
+        transport.addEdge(0, 1, 15, 0);
+        transport.addEdge(0, 2, 25, 0);
+        transport.addEdge(1, 3, 100, 4);
+        transport.addEdge(1, 4, 100, 6);
+        transport.addEdge(2, 3, 100, 5);
+        transport.addEdge(2, 4, 100, 3);
+        transport.addEdge(3, 5, 20, 0);
+        transport.addEdge(4, 5, 20, 0);
+        return transport.minCostFlow(0, 5, 40).second;
+    };
+    
+    cout << "4-ary heap:   $" << solve(MinCostFlow<IndexedDaryHeap<4>>(6)) << endl;
+    cout << "Dial buckets: $" << solve(MinCostFlow<DialBuckets>(6)) << endl;
+    cout << "Radix heap:   $" << solve(MinCostFlow<RadixHeap>(6)) << endl;
+    cout << "Expected total: $145" << endl << endl;
+}
+
 int main() {
     testMinCostFlow();
     testTransportationProblem();
     testAssignmentWithCosts();
     testSupplyChain();
+    testQueueChoice();
     
     cout << "=== Algorithm Summary ===" << endl;
     cout << "Successive Shortest Path: O(flow * (E + V log V))" << endl;
     cout << "  - Uses Dijkstra with potentials" << endl;
+    cout << "  - Queue is a template parameter (4-ary, Dial, radix)" << endl;
     cout << "  - Handles non-negative reduced costs" << endl << endl;
     
     cout << "Cycle Canceling: O(U * E^2 * log V)" << endl;
@@ -3,6 +3,7 @@
 #include <string>
 #include <algorithm>
 #include <cmath>
+#include "../graph/scc.h"
 
 // Pseudo-Omnipotence: Problems that appear hard but have efficient solutions
 // Demonstrates surprising polynomial-time algorithms
@@ -12,34 +13,11 @@
 class TwoSAT {
 private:
     int n;
-    std::vector<std::vector<int>> graph, graphT;
-    std::vector<bool> visited;
-    std::vector<int> order, comp;
-    
-    void dfs1(int v) {
-        visited[v] = true;
-        for (int u : graph[v]) {
-            if (!visited[u])
-                dfs1(u);
-        }
-        order.push_back(v);
-    }
-    
-    void dfs2(int v, int c) {
-        comp[v] = c;
-        for (int u : graphT[v]) {
-            if (comp[u] == -1)
-                dfs2(u, c);
-        }
-    }
+    CSRBuilder implications;  // Literal x is vertex x, ~x is vertex x + n
+    std::vector<int> comp;
     
 public:
-    TwoSAT(int variables) : n(variables) {
-        graph.resize(2 * n);
-        graphT.resize(2 * n);
-        visited.resize(2 * n, false);
-        comp.resize(2 * n, -1);
-    }
+    TwoSAT(int variables) : n(variables), implications(2 * variables) {}
     
     // Add clause (a v b) where a, b are literals
     // Positive literal: x, Negative literal: ~x represented as x + n
@@ -51,26 +29,13 @@ public:
         int notAVertex = a < n ? a + n : a - n;
         int notBVertex = b < n ? b + n : b - n;
         
-        graph[notAVertex].push_back(b);
-        graphT[b].push_back(notAVertex);
-        
-        graph[notBVertex].push_back(a);
-        graphT[a].push_back(notBVertex);
+        implications.addEdge(notAVertex, b);
+        implications.addEdge(notBVertex, a);
     }
     
     bool isSatisfiable() {
-        // Kosaraju's SCC algorithm
-        for (int i = 0; i < 2 * n; i++) {
-            if (!visited[i])
-                dfs1(i);
-        }
-        
-        int c = 0;
-        std::reverse(order.begin(), order.end());
-        for (int v : order) {
-            if (comp[v] == -1)
-                dfs2(v, c++);
-        }
+        // Iterative SCC (scc.h); components are numbered sinks first
+        comp = stronglyConnectedComponents(implications.graph()).component;
         
         // Check if x and ~x are in same SCC
         for (int i = 0; i < n; i++) {
@@ -84,7 +49,8 @@ public:
     std::vector<bool> getAssignment() {
         std::vector<bool> assignment(n);
         for (int i = 0; i < n; i++) {
-            // If comp[~x] > comp[x], assign x = true
+            // x is true when its component comes after ~x's in topological
+            // order, i.e. has the lower number
             assignment[i] = comp[i + n] > comp[i];
         }
         return assignment;